@@ -0,0 +1,237 @@
+#include "CoopScheduler.h"
+
+#if defined(__AVR__) && !defined(SCHED_IDLE_BUSY)
+#include <avr/sleep.h>
+#endif
+
+// detail implementation
+// init class
+CoopScheduler::CoopScheduler() {
+  task_count = 0;
+  idle_us = busy_us = 0;
+}
+
+/**
+ * add periodic task
+ * @method addTask
+ * @param  fn       task function
+ * @param  period   period in ms, the deadline moves by period after each run
+ * @param  priority higher runs first when several tasks are due
+ * @param  delay_ms time before the first run
+ * @return          task id or SCHED_NO_TASK if the table is full
+ */
+int8_t CoopScheduler::addTask(sched_task_fn fn, uint32_t period,
+                              uint8_t priority, uint32_t delay_ms) {
+  return add(fn, period, priority, delay_ms);
+}
+
+/**
+ * add task that runs once, runIn makes it run again
+ * @method addOneShot
+ * @param  fn       task function
+ * @param  delay_ms time before the run
+ * @param  priority higher runs first when several tasks are due
+ * @return          task id or SCHED_NO_TASK if the table is full
+ */
+int8_t CoopScheduler::addOneShot(sched_task_fn fn, uint32_t delay_ms,
+                                 uint8_t priority) {
+  return add(fn, 0, priority, delay_ms);
+}
+
+/**
+ * enable or disable a task, an enabled task is due right away
+ * @method setActive
+ */
+void CoopScheduler::setActive(int8_t id, bool active) {
+  if ((id < 0) || (id >= task_count)) {
+    return;
+  }
+  if (active && !tasks[id].active) {
+    tasks[id].deadline = millis();
+  }
+  tasks[id].active = active;
+}
+
+/**
+ * move the next run of a task, also from inside the task itself
+ * @method runIn
+ * @param  id       task id
+ * @param  delay_ms time from now
+ */
+void CoopScheduler::runIn(int8_t id, uint32_t delay_ms) {
+  if ((id < 0) || (id >= task_count)) {
+    return;
+  }
+  tasks[id].deadline = millis() + delay_ms;
+  tasks[id].active = true;
+}
+
+/**
+ * run the most urgent due task
+ * @method run
+ * @return  false if nothing was due
+ */
+bool CoopScheduler::run(void) {
+  uint32_t t_now = millis();
+  int8_t id = nextDue(t_now);
+  if (id == SCHED_NO_TASK) {
+    return false;
+  }
+
+  sched_task_t *task = &tasks[id];
+  uint32_t late = t_now - task->deadline;
+  if (late > task->stats.late_max_ms) {
+    task->stats.late_max_ms = (late > 0xFFFF) ? 0xFFFF : late;
+  }
+
+  // next deadline before the run, so the task can still move it
+  if (task->period) {
+    task->deadline += task->period;
+    if (late >= task->period) {
+      // too late, drop the missed periods instead of running them back to back
+      task->stats.skipped += late / task->period;
+      task->deadline = t_now + task->period;
+    }
+  } else {
+    task->active = false;
+  }
+
+  uint32_t t_start = micros();
+  task->fn();
+  uint32_t t_run = micros() - t_start;
+
+  task->stats.runs++;
+  task->stats.run_total_us += t_run;
+  if (t_run > task->stats.run_max_us) {
+    task->stats.run_max_us = t_run;
+  }
+  busy_us += t_run;
+  return true;
+}
+
+/**
+ * run one due task or idle until the next deadline, call it from loop()
+ * @method loop
+ */
+void CoopScheduler::loop(void) {
+  if (run() || (untilNext() == 0xFFFFFFFF)) {
+    return;
+  }
+
+  uint32_t t_start = micros();
+#if defined(__AVR__) && !defined(SCHED_IDLE_BUSY)
+  // idle sleep, the millis timer wakes the cpu every ms
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  while (untilNext() > 0) {
+    sleep_mode();
+  }
+#else
+  while (untilNext() > 0) {
+  }
+#endif
+  idle_us += micros() - t_start;
+}
+
+/**
+ * time until the next deadline
+ * @method untilNext
+ * @return  ms, 0 if a task is due, 0xFFFFFFFF if there is none
+ */
+uint32_t CoopScheduler::untilNext(void) {
+  uint32_t t_now = millis();
+  uint32_t wait = 0xFFFFFFFF;
+
+  for (uint8_t i = 0; i < task_count; i++) {
+    if (!tasks[i].active) {
+      continue;
+    }
+    int32_t left = (int32_t)(tasks[i].deadline - t_now);
+    if (left <= 0) {
+      return 0;
+    }
+    if ((uint32_t)left < wait) {
+      wait = left;
+    }
+  }
+  return wait;
+}
+
+/**
+ * copy the statistic of a task
+ * @method getStats
+ * @return  false for an unknown id
+ */
+bool CoopScheduler::getStats(int8_t id, sched_stats_t *stats) {
+  if ((id < 0) || (id >= task_count)) {
+    return false;
+  }
+  *stats = tasks[id].stats;
+  return true;
+}
+
+/**
+ * time spent waiting for a deadline in loop, us
+ * @method idleTime
+ */
+uint32_t CoopScheduler::idleTime(void) { return idle_us; }
+
+/**
+ * time spent in tasks, us
+ * @method busyTime
+ */
+uint32_t CoopScheduler::busyTime(void) { return busy_us; }
+
+/**
+ * reset all statistic
+ * @method clearStats
+ */
+void CoopScheduler::clearStats(void) {
+  for (uint8_t i = 0; i < task_count; i++) {
+    memset(&tasks[i].stats, 0, sizeof(tasks[i].stats));
+  }
+  idle_us = busy_us = 0;
+}
+
+/**
+ * fill a task slot
+ * @method add
+ */
+int8_t CoopScheduler::add(sched_task_fn fn, uint32_t period, uint8_t priority,
+                          uint32_t delay_ms) {
+  if ((fn == NULL) || (task_count >= SCHED_MAX_TASKS)) {
+    return SCHED_NO_TASK;
+  }
+  sched_task_t *task = &tasks[task_count];
+  task->fn = fn;
+  task->period = period;
+  task->deadline = millis() + delay_ms;
+  task->priority = priority;
+  task->active = true;
+  memset(&task->stats, 0, sizeof(task->stats));
+  return task_count++;
+}
+
+/**
+ * due task with the highest priority, earliest deadline first on a tie
+ * @method nextDue
+ */
+int8_t CoopScheduler::nextDue(uint32_t t_now) {
+  int8_t best = SCHED_NO_TASK;
+  int32_t best_late = 0;
+
+  for (uint8_t i = 0; i < task_count; i++) {
+    if (!tasks[i].active) {
+      continue;
+    }
+    int32_t late = (int32_t)(t_now - tasks[i].deadline);
+    if (late < 0) {
+      continue;
+    }
+    if ((best == SCHED_NO_TASK) || (tasks[i].priority > tasks[best].priority) ||
+        ((tasks[i].priority == tasks[best].priority) && (late > best_late))) {
+      best = i;
+      best_late = late;
+    }
+  }
+  return best;
+}
@@ -0,0 +1,73 @@
+#ifndef COOPSCHEDULER_H
+#define COOPSCHEDULER_H
+
+#if ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+// max task in the table
+#ifndef SCHED_MAX_TASKS
+#define SCHED_MAX_TASKS 8
+#endif
+
+// no task id
+#define SCHED_NO_TASK -1
+
+// task function
+typedef void (*sched_task_fn)(void);
+
+// per task statistic, times in microseconds except lateness in milliseconds
+typedef struct {
+  uint32_t runs;
+  uint32_t run_total_us;
+  uint32_t run_max_us;
+  uint16_t late_max_ms;    // worst start after the deadline (jitter)
+  uint16_t skipped;        // periods dropped because the task was too late
+} sched_stats_t;
+
+// cooperative scheduler over a static task table. a task runs to completion,
+// the next one is the due task with the highest priority, earliest deadline
+// first between equal priorities. when nothing is due the loop idles until
+// the next deadline and that time is counted as idle. on AVR the cpu is put
+// in idle sleep while it waits, define SCHED_IDLE_BUSY to spin instead.
+class CoopScheduler {
+public:
+  CoopScheduler();
+
+  int8_t addTask(sched_task_fn fn, uint32_t period, uint8_t priority = 0,
+                 uint32_t delay_ms = 0);
+  int8_t addOneShot(sched_task_fn fn, uint32_t delay_ms, uint8_t priority = 0);
+  void setActive(int8_t id, bool active);
+  void runIn(int8_t id, uint32_t delay_ms);
+
+  bool run(void);
+  void loop(void);
+  uint32_t untilNext(void);
+
+  bool getStats(int8_t id, sched_stats_t *stats);
+  uint32_t idleTime(void);
+  uint32_t busyTime(void);
+  void clearStats(void);
+
+private:
+  typedef struct {
+    sched_task_fn fn;
+    uint32_t period;       // 0 for one shot
+    uint32_t deadline;
+    uint8_t priority;
+    bool active;
+    sched_stats_t stats;
+  } sched_task_t;
+
+  sched_task_t tasks[SCHED_MAX_TASKS];
+  uint8_t task_count;
+  uint32_t idle_us, busy_us;
+
+  int8_t add(sched_task_fn fn, uint32_t period, uint8_t priority,
+             uint32_t delay_ms);
+  int8_t nextDue(uint32_t t_now);
+};
+
+#endif
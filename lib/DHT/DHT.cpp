@@ -8,6 +8,22 @@ written by Adafruit Industries
 
 #define MIN_INTERVAL 2000
 
+// Non-blocking acquisition timing, in milliseconds.
+#define WAKE_TIME 250
+// A full frame takes ~4 ms, give up if it is not complete after this.
+#define FRAME_TIMEOUT 10
+
+// Start signal hold time, in microseconds: the DHT11 needs at least 18 ms,
+// the DHT22/AM2301 at least 1 ms.
+#define START_TIME_DHT11 20000
+#define START_TIME_DHT22 1100
+
+// Falling edges before the first data bit ends: the sensor response low
+// pulse and the end of the 80 us high pulse that follows it.
+#define PREAMBLE_FALLS 2
+
+DHT *DHT::_isrinstance = NULL;
+
 DHT::DHT(uint8_t pin, uint8_t type, uint8_t count) {
   _pin = pin;
   _type = type;
@@ -19,6 +35,12 @@ DHT::DHT(uint8_t pin, uint8_t type, uint8_t count) {
                                                  // reading pulses from DHT sensor.
   // Note that count is now ignored as the DHT reading algorithm adjusts itself
   // basd on the speed of the processor.
+  _state = DHT_STATE_IDLE;
+  _startlong = false;
+  _autotype = DHT_FRAME_UNKNOWN;
+  _autocount = 0;
+  _preamblecycles = 0;
+  clearStats();
 }
 
 void DHT::begin(void) {
@@ -36,91 +58,102 @@ float DHT::readTemperature(bool S, bool force) {
   float f = NAN;
 
   if (read(force)) {
-    switch (_type) {
-    case DHT11:
-      f = data[2];
-      if(S) {
-        f = convertCtoF(f);
-      }
-      break;
-    case DHT22:
-    case DHT21:
-      f = data[2] & 0x7F;
-      f *= 256;
-      f += data[3];
-      f *= 0.1;
-      if (data[2] & 0x80) {
-        f *= -1;
-      }
-      if(S) {
-        f = convertCtoF(f);
-      }
-      break;
-    }
+    f = decodeTemperature(S);
   }
   return f;
 }
 
 float DHT::convertCtoF(float c) {
-  return c * 1.8 + 32;
+  return dht_c_to_f(c);
 }
 
 float DHT::convertFtoC(float f) {
-  return (f - 32) * 0.55555;
+  return dht_f_to_c(f);
 }
 
 float DHT::readHumidity(bool force) {
   float f = NAN;
-  if (read()) {
-    switch (_type) {
-    case DHT11:
-      f = data[0];
-      break;
-    case DHT22:
-    case DHT21:
-      f = data[0];
-      f *= 256;
-      f += data[1];
-      f *= 0.1;
-      break;
-    }
+  if (read(force)) {
+    f = decodeHumidity();
   }
   return f;
 }
 
-//boolean isFahrenheit: True == Fahrenheit; False == Celcius
-float DHT::computeHeatIndex(float temperature, float percentHumidity, bool isFahrenheit) {
-  // Using both Rothfusz and Steadman's equations
-  // http://www.wpc.ncep.noaa.gov/html/heatindex_equation.shtml
-  float hi;
+// Acquire one frame and decode temperature and humidity from it, so both
+// values always come from the same measurement.
+bool DHT::readBoth(float &t, float &h, bool S, bool force) {
+  if (!read(force)) {
+    t = h = NAN;
+    return false;
+  }
+  t = decodeTemperature(S);
+  h = decodeHumidity();
+  return true;
+}
 
-  if (!isFahrenheit)
-    temperature = convertCtoF(temperature);
+// Copy the last frame received (valid or not) and return whether it passed
+// the checksum.
+bool DHT::getRawFrame(uint8_t *frame) {
+  memcpy(frame, data, sizeof(data));
+  return _lastresult;
+}
 
-  hi = 0.5 * (temperature + 61.0 + ((temperature - 68.0) * 1.2) + (percentHumidity * 0.094));
+float DHT::decodeTemperature(bool S) {
+  float f = NAN;
 
-  if (hi > 79) {
-    hi = -42.379 +
-             2.04901523 * temperature +
-            10.14333127 * percentHumidity +
-            -0.22475541 * temperature*percentHumidity +
-            -0.00683783 * pow(temperature, 2) +
-            -0.05481717 * pow(percentHumidity, 2) +
-             0.00122874 * pow(temperature, 2) * percentHumidity +
-             0.00085282 * temperature*pow(percentHumidity, 2) +
-            -0.00000199 * pow(temperature, 2) * pow(percentHumidity, 2);
+  switch (frameType()) {
+  case DHT11:
+    f = data[2];
+    if(S) {
+      f = convertCtoF(f);
+    }
+    break;
+  case DHT22:
+  case DHT21:
+    f = data[2] & 0x7F;
+    f *= 256;
+    f += data[3];
+    f *= 0.1;
+    if (data[2] & 0x80) {
+      f *= -1;
+    }
+    if(S) {
+      f = convertCtoF(f);
+    }
+    break;
+  }
+  return f;
+}
 
-    if((percentHumidity < 13) && (temperature >= 80.0) && (temperature <= 112.0))
-      hi -= ((13.0 - percentHumidity) * 0.25) * sqrt((17.0 - abs(temperature - 95.0)) * 0.05882);
+float DHT::decodeHumidity(void) {
+  float f = NAN;
 
-    else if((percentHumidity > 85.0) && (temperature >= 80.0) && (temperature <= 87.0))
-      hi += ((percentHumidity - 85.0) * 0.1) * ((87.0 - temperature) * 0.2);
+  switch (frameType()) {
+  case DHT11:
+    f = data[0];
+    break;
+  case DHT22:
+  case DHT21:
+    f = data[0];
+    f *= 256;
+    f += data[1];
+    f *= 0.1;
+    break;
   }
+  return f;
+}
 
-  return isFahrenheit ? hi : convertFtoC(hi);
+//boolean isFahrenheit: True == Fahrenheit; False == Celcius
+float DHT::computeHeatIndex(float temperature, float percentHumidity, bool isFahrenheit) {
+  return dht_heat_index(temperature, percentHumidity, isFahrenheit);
 }
 
 boolean DHT::read(bool force) {
+  // A non-blocking acquisition owns the data line until it is done.
+  if ((_state != DHT_STATE_IDLE) && (_state != DHT_STATE_DONE)) {
+    return _lastresult;
+  }
+
   // Check if sensor was read less than two seconds ago and return early
   // to use last reading.
   uint32_t currenttime = millis();
@@ -140,12 +173,15 @@ boolean DHT::read(bool force) {
   digitalWrite(_pin, HIGH);
   delay(250);
 
-  // First set data line low for 20 milliseconds.
+  // First set data line low for the start signal of this sensor type.
   pinMode(_pin, OUTPUT);
   digitalWrite(_pin, LOW);
-  delay(20);
+  delay(startTime() / 1000);
+  delayMicroseconds(startTime() % 1000);
 
-  uint32_t cycles[80];
+  bool timeout = false;
+  // loop counts spent with interrupts disabled
+  uint32_t busycycles = 0;
   {
     // Turn off interrupts temporarily because the next sections are timing critical
     // and we don't want any interruptions.
@@ -161,16 +197,29 @@ boolean DHT::read(bool force) {
 
     // First expect a low signal for ~80 microseconds followed by a high signal
     // for ~80 microseconds again.
-    if (expectPulse(LOW) == 0) {
+    dht_count_t response = expectPulse(LOW, _maxcycles);
+    if (response == 0) {
       DEBUG_PRINTLN(F("Timeout waiting for start signal low pulse."));
       _lastresult = false;
+      detectType();
+      recordAcquisition(DHT_RESULT_START_TIMEOUT, startTime() / 1000,
+                        irqOffTime(_maxcycles));
       return _lastresult;
     }
-    if (expectPulse(HIGH) == 0) {
+    // The high half of the preamble is a full 80 us, use it to calibrate the
+    // timeout of the data pulses (none is longer than ~75 us) to this clock.
+    dht_count_t preamble = expectPulse(HIGH, _maxcycles);
+    if (preamble == 0) {
       DEBUG_PRINTLN(F("Timeout waiting for start signal high pulse."));
       _lastresult = false;
+      detectType();
+      recordAcquisition(DHT_RESULT_START_TIMEOUT, startTime() / 1000,
+                        irqOffTime((uint32_t)response + _maxcycles));
       return _lastresult;
     }
+    _preamblecycles = preamble;
+    busycycles = (uint32_t)response + preamble;
+    dht_count_t pulsecycles = 2 * preamble;
 
     // Now read the 40 bits sent by the sensor.  Each bit is sent as a 50
     // microsecond low pulse followed by a variable length high pulse.  If the
@@ -178,35 +227,42 @@ boolean DHT::read(bool force) {
     // then it's a 1.  We measure the cycle count of the initial 50us low pulse
     // and use that to compare to the cycle count of the high pulse to determine
     // if the bit is a 0 (high state cycle count < low state cycle count), or a
-    // 1 (high state cycle count > low state cycle count). Note that for speed all
-    // the pulses are read into a array and then examined in a later step.
-    for (int i=0; i<80; i+=2) {
-      cycles[i]   = expectPulse(LOW);
-      cycles[i+1] = expectPulse(HIGH);
+    // 1 (high state cycle count > low state cycle count).  Each bit is shifted
+    // into data[] as soon as its high pulse ends, which costs a few cycles at
+    // the start of the next 50us low pulse and keeps only two counts live.
+    for (uint8_t i=0; i<40; ++i) {
+      dht_count_t lowCycles  = expectPulse(LOW, pulsecycles);
+      dht_count_t highCycles = expectPulse(HIGH, pulsecycles);
+      busycycles += (uint32_t)lowCycles + highCycles;
+      if ((lowCycles == 0) || (highCycles == 0)) {
+        timeout = true;
+        busycycles += pulsecycles;
+        break;
+      }
+      dht_decode_bit(data, i, lowCycles, highCycles);
     }
   } // Timing critical code is now complete.
 
-  // Inspect pulses and determine which ones are 0 (high state cycle count < low
-  // state cycle count), or 1 (high state cycle count > low state cycle count).
-  for (int i=0; i<40; ++i) {
-    uint32_t lowCycles  = cycles[2*i];
-    uint32_t highCycles = cycles[2*i+1];
-    if ((lowCycles == 0) || (highCycles == 0)) {
-      DEBUG_PRINTLN(F("Timeout waiting for pulse."));
-      _lastresult = false;
-      return _lastresult;
-    }
-    data[i/8] <<= 1;
-    // Now compare the low and high cycle times to see if the bit is a 0 or 1.
-    if (highCycles > lowCycles) {
-      // High cycles are greater than 50us low cycle count, must be a 1.
-      data[i/8] |= 1;
-    }
-    // Else high cycles are less than (or equal to, a weird case) the 50us low
-    // cycle count so this must be a zero.  Nothing needs to be changed in the
-    // stored data.
+  uint32_t irqoff = irqOffTime(busycycles);
+  uint32_t duration = (startTime() + irqoff + 500) / 1000;
+
+  if (timeout) {
+    DEBUG_PRINTLN(F("Timeout waiting for pulse."));
+    _lastresult = false;
+    detectType();
+    recordAcquisition(DHT_RESULT_BIT_TIMEOUT, duration, irqoff);
+    return _lastresult;
   }
 
+  checkFrame();
+  detectType();
+  recordAcquisition(_lastresult ? DHT_RESULT_OK : DHT_RESULT_CHECKSUM,
+                    duration, irqoff);
+  return _lastresult;
+}
+
+// Check the 40 bits in data[] against their checksum and remember the result.
+bool DHT::checkFrame(void) {
   DEBUG_PRINTLN(F("Received:"));
   DEBUG_PRINT(data[0], HEX); DEBUG_PRINT(F(", "));
   DEBUG_PRINT(data[1], HEX); DEBUG_PRINT(F(", "));
@@ -216,7 +272,7 @@ boolean DHT::read(bool force) {
   DEBUG_PRINTLN((data[0] + data[1] + data[2] + data[3]) & 0xFF, HEX);
 
   // Check we read 40 bits and that the checksum matches.
-  if (data[4] == ((data[0] + data[1] + data[2] + data[3]) & 0xFF)) {
+  if (dht_check_frame(data) == DHT_DECODE_OK) {
     _lastresult = true;
     return _lastresult;
   }
@@ -231,17 +287,19 @@ boolean DHT::read(bool force) {
 // return a count of loop cycles spent at that level (this cycle count can be
 // used to compare the relative time of two pulses).  If more than a millisecond
 // ellapses without the level changing then the call fails with a 0 response.
+// The count is 16 bits wide when the clock is slow enough for a millisecond
+// of loop cycles to fit (see dht_count_t).
 // This is adapted from Arduino's pulseInLong function (which is only available
 // in the very latest IDE versions):
 //   https://github.com/arduino/Arduino/blob/master/hardware/arduino/avr/cores/arduino/wiring_pulse.c
-uint32_t DHT::expectPulse(bool level) {
-  uint32_t count = 0;
+dht_count_t DHT::expectPulse(bool level, dht_count_t maxcycles) {
+  dht_count_t count = 0;
   // On AVR platforms use direct GPIO port access as it's much faster and better
   // for catching pulses that are 10's of microseconds in length:
   #ifdef __AVR
     uint8_t portState = level ? _bit : 0;
     while ((*portInputRegister(_port) & _bit) == portState) {
-      if (count++ >= _maxcycles) {
+      if (count++ >= maxcycles) {
         return 0; // Exceeded timeout, fail.
       }
     }
@@ -249,7 +307,7 @@ uint32_t DHT::expectPulse(bool level) {
   // right now, perhaps bugs in direct port access functions?).
   #else
     while (digitalRead(_pin) == level) {
-      if (count++ >= _maxcycles) {
+      if (count++ >= maxcycles) {
         return 0; // Exceeded timeout, fail.
       }
     }
@@ -257,3 +315,348 @@ uint32_t DHT::expectPulse(bool level) {
 
   return count;
 }
+
+// Whether the data line can be captured by an interrupt, the condition for
+// the non-blocking acquisition.
+bool DHT::canCapture(void) {
+  #ifdef DHT_USE_INPUT_CAPTURE
+    if (_pin == DHT_ICP1_PIN) {
+      return true;
+    }
+  #endif
+  return digitalPinToInterrupt(_pin) != NOT_AN_INTERRUPT;
+}
+
+bool DHT::startRead(bool force) {
+  if ((_state != DHT_STATE_IDLE) && (_state != DHT_STATE_DONE)) {
+    return false;
+  }
+  // No edge interrupt on this pin, only the blocking read() works here.
+  if (!canCapture()) {
+    return false;
+  }
+  // Only one sensor can own the edge interrupt at a time.
+  if ((_isrinstance != NULL) && (_isrinstance != this)) {
+    return false;
+  }
+  uint32_t currenttime = millis();
+  if (!force && ((currenttime - _lastreadtime) < MIN_INTERVAL)) {
+    return false;
+  }
+  _lastreadtime = currenttime;
+
+  // Go into high impedence state to let pull-up raise data line level, the
+  // rest of the start signal is sent from poll().
+  digitalWrite(_pin, HIGH);
+  _statetime = currenttime;
+  _state = DHT_STATE_WAKE;
+  return true;
+}
+
+uint8_t DHT::poll(void) {
+  uint32_t currenttime = millis();
+
+  switch (_state) {
+  case DHT_STATE_WAKE:
+    if ((currenttime - _statetime) >= WAKE_TIME) {
+      // Set data line low for the start signal.
+      pinMode(_pin, OUTPUT);
+      digitalWrite(_pin, LOW);
+      _statetime = micros();
+      _acqstart = currenttime;
+      _state = DHT_STATE_START;
+    }
+    break;
+
+  case DHT_STATE_START:
+    // 1 ms is a single millis() tick, time the hold in microseconds.
+    if ((micros() - _statetime) >= startTime()) {
+      if (!beginCapture()) {
+        // startRead() checked the pin, so this only happens when another
+        // instance took the interrupt meanwhile.  Never block here, release
+        // the line and fail the acquisition.
+        pinMode(_pin, INPUT_PULLUP);
+        _lastresult = false;
+        recordAcquisition(DHT_RESULT_START_TIMEOUT, currenttime - _acqstart, 0);
+        _state = DHT_STATE_DONE;
+        break;
+      }
+
+      // End the start signal and let the sensor drive the line.
+      digitalWrite(_pin, HIGH);
+      delayMicroseconds(40);
+      pinMode(_pin, INPUT_PULLUP);
+
+      _statetime = currenttime;
+      _state = DHT_STATE_ACQUIRE;
+    }
+    break;
+
+  case DHT_STATE_ACQUIRE:
+    if (_falls >= (PREAMBLE_FALLS + 40)) {
+      endCapture();
+      checkFrame();
+      detectType();
+      recordAcquisition(_lastresult ? DHT_RESULT_OK : DHT_RESULT_CHECKSUM,
+                        currenttime - _acqstart, 0);
+      _state = DHT_STATE_DONE;
+    } else if ((currenttime - _statetime) > FRAME_TIMEOUT) {
+      endCapture();
+      DEBUG_PRINTLN(F("Timeout waiting for frame."));
+      _lastresult = false;
+      detectType();
+      recordAcquisition((_falls >= PREAMBLE_FALLS) ? DHT_RESULT_BIT_TIMEOUT
+                                                   : DHT_RESULT_START_TIMEOUT,
+                        currenttime - _acqstart, 0);
+      _state = DHT_STATE_DONE;
+    }
+    break;
+  }
+  return _state;
+}
+
+bool DHT::getResult(void) {
+  return _lastresult;
+}
+
+uint8_t DHT::getType(void) {
+  return _type;
+}
+
+// Decode the frame of the finished non-blocking acquisition.
+bool DHT::getResult(float &t, float &h, bool S) {
+  if ((_state != DHT_STATE_DONE) || !_lastresult) {
+    t = h = NAN;
+    return false;
+  }
+  t = decodeTemperature(S);
+  h = decodeHumidity();
+  // A valid frame of a layout DHT_AUTO has not settled on decodes to NaN.
+  return !isnan(t) && !isnan(h);
+}
+
+void DHT::clearResult(void) {
+  if (_state == DHT_STATE_DONE) {
+    _state = DHT_STATE_IDLE;
+  }
+}
+
+void DHT::getStats(dht_stats_t *stats) {
+  *stats = _stats;
+}
+
+void DHT::clearStats(void) {
+  memset(&_stats, 0, sizeof(_stats));
+}
+
+// Microseconds with interrupts disabled in read(): 50 us of fixed delays plus
+// busycycles loop counts scaled by the last 80 us preamble, 0 until a
+// preamble has been measured.
+uint32_t DHT::irqOffTime(uint32_t busycycles) {
+  if (_preamblecycles == 0) {
+    return 0;
+  }
+  return 50 + (busycycles * 80) / _preamblecycles;
+}
+
+// Count the outcome of one acquisition, duration in milliseconds from the
+// start signal and irqoff in microseconds.
+void DHT::recordAcquisition(uint8_t result, uint32_t duration, uint32_t irqoff) {
+  switch (result) {
+  case DHT_RESULT_OK:
+    _stats.ok++;
+    break;
+  case DHT_RESULT_START_TIMEOUT:
+    _stats.start_timeouts++;
+    break;
+  case DHT_RESULT_BIT_TIMEOUT:
+    _stats.bit_timeouts++;
+    break;
+  default:
+    _stats.checksum_failures++;
+    break;
+  }
+
+  uint32_t bin = duration / DHT_STATS_BIN_MS;
+  if (bin >= DHT_STATS_BINS) {
+    bin = DHT_STATS_BINS - 1;
+  }
+  if (_stats.duration_hist[bin] < 0xFFFF) {
+    _stats.duration_hist[bin]++;
+  }
+
+  _stats.irq_off_total_us += irqoff;
+  if (irqoff > _stats.irq_off_max_us) {
+    _stats.irq_off_max_us = (irqoff > 0xFFFF) ? 0xFFFF : irqoff;
+  }
+}
+
+// Start signal hold time in microseconds for the configured or detected type.
+uint16_t DHT::startTime(void) {
+  switch (_type) {
+  case DHT11:
+    return START_TIME_DHT11;
+  case DHT22:
+  case DHT21:
+    return START_TIME_DHT22;
+  default:
+    return _startlong ? START_TIME_DHT11 : START_TIME_DHT22;
+  }
+}
+
+// Frame layout used to decode data[]: the configured type, or for DHT_AUTO
+// the layout of the last valid frame until the type is confirmed.
+uint8_t DHT::frameType(void) {
+  return (_type != DHT_AUTO) ? _type : _autotype;
+}
+
+// Sensor type detection for DHT_AUTO, called after every acquisition.  Which
+// start signal got an answer says nothing about the type (many DHT22 answer
+// the 20 ms one as well, and a DHT11 may answer 1 ms partly), so the type is
+// taken from the contents of the frames, see dht_classify_frame().  As long
+// as no valid frame with a known layout comes back the next acquisition
+// tries the other start signal; the type is fixed once DHT_AUTO_CONFIRM
+// frames in a row had the same layout.  Both DHT22 and AM2301 use the same
+// frame format.
+void DHT::detectType(void) {
+  if (_type != DHT_AUTO) {
+    return;
+  }
+  uint8_t layout = _lastresult ? dht_classify_frame(data) : DHT_FRAME_UNKNOWN;
+  if (layout == DHT_FRAME_UNKNOWN) {
+    _startlong = !_startlong;
+    _autotype = DHT_FRAME_UNKNOWN;
+    _autocount = 0;
+    return;
+  }
+  if (layout != _autotype) {
+    _autotype = layout;
+    _autocount = 0;
+  }
+  if (++_autocount >= DHT_AUTO_CONFIRM) {
+    _type = layout;
+    DEBUG_PRINT(F("Detected DHT")); DEBUG_PRINTLN(_type, DEC);
+  }
+}
+
+// Route the edges of the data line to this instance, either through the
+// Timer1 input capture unit or through the external interrupt of the pin
+// (attachInterrupt).  Fails on pins that have neither.
+bool DHT::beginCapture(void) {
+  if ((_isrinstance != NULL) && (_isrinstance != this)) {
+    return false;
+  }
+  data[0] = data[1] = data[2] = data[3] = data[4] = 0;
+  _falls = 0;
+  _released = false;
+
+  #ifdef DHT_USE_INPUT_CAPTURE
+    if (_pin == DHT_ICP1_PIN) {
+      _isrinstance = this;
+      // Free-running Timer1 at F_CPU/8 (0.5 us per tick at 16 MHz), capture
+      // the first falling edge.  The previous setup is restored afterwards.
+      _savedtccr1a = TCCR1A;
+      _savedtccr1b = TCCR1B;
+      _savedtimsk1 = TIMSK1;
+      TCCR1A = 0;
+      TCCR1B = _BV(ICNC1) | _BV(CS11);
+      _lastedge = TCNT1;
+      TIFR1 = _BV(ICF1);
+      TIMSK1 = _BV(ICIE1);
+      // Only falling edges are armed and the stale capture is cleared, the
+      // release of the line is not seen here.
+      _released = true;
+      return true;
+    }
+  #endif
+
+  int irq = digitalPinToInterrupt(_pin);
+  if (irq == NOT_AN_INTERRUPT) {
+    return false;
+  }
+  _isrinstance = this;
+  _lastedge = micros();
+  // The line is held low here.  The external interrupt flag may still hold
+  // the falling edge of the start signal (it latches whenever the pin mode
+  // allows it, attached or not) and fire as soon as CHANGE is attached, so
+  // handleEdge() ignores falls until the line has been released.
+  attachInterrupt(irq, edgeISR, CHANGE);
+  return true;
+}
+
+void DHT::endCapture(void) {
+  #ifdef DHT_USE_INPUT_CAPTURE
+    if (_pin == DHT_ICP1_PIN) {
+      TIMSK1 = _savedtimsk1;
+      TCCR1A = _savedtccr1a;
+      TCCR1B = _savedtccr1b;
+      _isrinstance = NULL;
+      return;
+    }
+  #endif
+  detachInterrupt(digitalPinToInterrupt(_pin));
+  _isrinstance = NULL;
+}
+
+// Decode one edge of the frame.  Each bit is a ~50 us low pulse followed by a
+// high pulse of ~28 us (0) or ~70 us (1), so a bit is complete on the falling
+// edge that ends its high pulse and is a 1 when that high pulse outlasted the
+// low pulse before it, the same rule read() applies to the cycle counts.
+// width is the time since the previous edge, in any unit.  Falls before the
+// line is released at the end of the start signal are stale and ignored.
+void DHT::handleEdge(bool level, uint16_t width) {
+  if (level) {
+    _lowtime = width;
+    _released = true;
+    return;
+  }
+  if (!_released) {
+    return;
+  }
+  uint8_t falls = _falls;
+  if ((falls >= PREAMBLE_FALLS) && (falls < (PREAMBLE_FALLS + 40))) {
+    dht_decode_bit(data, falls - PREAMBLE_FALLS, _lowtime, width);
+  }
+  _falls = falls + 1;
+}
+
+void DHT::edgeISR(void) {
+  if (_isrinstance == NULL) {
+    return;
+  }
+  DHT *dht = _isrinstance;
+  uint32_t now = micros();
+  uint32_t width = now - dht->_lastedge;
+  dht->_lastedge = now;
+
+  #ifdef __AVR
+    bool level = (*portInputRegister(dht->_port) & dht->_bit) != 0;
+  #else
+    bool level = digitalRead(dht->_pin) == HIGH;
+  #endif
+
+  dht->handleEdge(level, width > 0xFFFF ? 0xFFFF : width);
+}
+
+#ifdef DHT_USE_INPUT_CAPTURE
+void DHT::captureISR(void) {
+  // The edge just captured is the one ICES1 was armed for; arm the other one.
+  // Changing ICES1 can raise a spurious capture flag, so clear it.
+  uint16_t now = ICR1;
+  bool level = (TCCR1B & _BV(ICES1)) != 0;
+  TCCR1B ^= _BV(ICES1);
+  TIFR1 = _BV(ICF1);
+
+  if (_isrinstance == NULL) {
+    return;
+  }
+  DHT *dht = _isrinstance;
+  uint16_t width = now - (uint16_t)dht->_lastedge;
+  dht->_lastedge = now;
+  dht->handleEdge(level, width);
+}
+
+ISR(TIMER1_CAPT_vect) {
+  DHT::captureISR();
+}
+#endif
@@ -12,6 +12,9 @@ written by Adafruit Industries
  #include "WProgram.h"
 #endif
 
+#include "DHT_decode.h"
+#include "DHT_heat.h"
+
 
 // Uncomment to enable printing out nice debug messages.
 //#define DHT_DEBUG
@@ -28,11 +31,75 @@ written by Adafruit Industries
   #define DEBUG_PRINTLN(...) {}
 #endif
 
-// Define types of sensors.
+// Define DHT_USE_INPUT_CAPTURE to timestamp the frame edges with the Timer1
+// input capture unit when the sensor is on the ICP1 pin (digital 8 on the
+// ATmega328).  The driver then owns TIMER1_CAPT_vect and reconfigures Timer1
+// for the ~5 ms of each acquisition.  Other pins need an external interrupt
+// (see digitalPinToInterrupt(), INT0/INT1 on digital 2 and 3 of the ATmega328);
+// there is no pin change interrupt path, startRead() fails on any other pin
+// and only the blocking read() is available.
+#if defined(DHT_USE_INPUT_CAPTURE) && !(defined(__AVR) && defined(ICR1))
+  #undef DHT_USE_INPUT_CAPTURE
+#endif
+#ifndef DHT_ICP1_PIN
+  #define DHT_ICP1_PIN 8
+#endif
+
+// Pulse length counter of the blocking read.  A millisecond of busy loop fits
+// in 16 bits up to ~65 MHz, which saves the 32-bit arithmetic on AVR.
+#if defined(F_CPU) && (F_CPU <= 65000000L)
+typedef uint16_t dht_count_t;
+#else
+typedef uint32_t dht_count_t;
+#endif
+
+// Outcome of an acquisition, as counted in dht_stats_t.
+#define DHT_RESULT_OK 0
+#define DHT_RESULT_START_TIMEOUT 1
+#define DHT_RESULT_BIT_TIMEOUT 2
+#define DHT_RESULT_CHECKSUM 3
+
+// Define types of sensors.  DHT_AUTO detects DHT11 or DHT22/AM2301 from the
+// contents of the frames received, see getType().  The type is confirmed by
+// DHT_AUTO_CONFIRM valid frames in a row with the same layout.
+#define DHT_AUTO 0
 #define DHT11 11
 #define DHT22 22
 #define DHT21 21
 #define AM2301 21
+#ifndef DHT_AUTO_CONFIRM
+  #define DHT_AUTO_CONFIRM 2
+#endif
+
+// States of the non-blocking acquisition (startRead/poll).
+#define DHT_STATE_IDLE 0     // no acquisition in progress
+#define DHT_STATE_WAKE 1     // data line released high before the start signal
+#define DHT_STATE_START 2    // start signal, data line held low
+#define DHT_STATE_ACQUIRE 3  // frame being decoded by the edge interrupt
+#define DHT_STATE_DONE 4     // frame complete, result available
+
+// Acquisition health counters, see getStats().  The duration histogram has
+// DHT_STATS_BINS bins of DHT_STATS_BIN_MS from the start signal to the end of
+// the frame, the last bin also counts everything longer.  Interrupt-off time
+// is the part of a blocking read() spent with interrupts disabled, estimated
+// from the loop counts calibrated on the 80 us preamble; the non-blocking
+// acquisition keeps interrupts enabled and adds nothing to it.
+#ifndef DHT_STATS_BINS
+  #define DHT_STATS_BINS 8
+#endif
+#ifndef DHT_STATS_BIN_MS
+  #define DHT_STATS_BIN_MS 4
+#endif
+
+typedef struct {
+  uint32_t ok;
+  uint32_t start_timeouts;     // sensor did not answer the start signal
+  uint32_t bit_timeouts;       // sensor answered but the frame was cut short
+  uint32_t checksum_failures;
+  uint16_t duration_hist[DHT_STATS_BINS];  // saturates at 0xFFFF
+  uint16_t irq_off_max_us;
+  uint32_t irq_off_total_us;
+} dht_stats_t;
 
 
 class DHT {
@@ -45,6 +112,32 @@ class DHT {
    float computeHeatIndex(float temperature, float percentHumidity, bool isFahrenheit=true);
    float readHumidity(bool force=false);
    boolean read(bool force=false);
+   bool readBoth(float &t, float &h, bool S=false, bool force=false);
+   bool getRawFrame(uint8_t *frame);
+
+   // Non-blocking acquisition driven by millis() and an edge interrupt.
+   // startRead() begins an acquisition and poll() advances it; once poll()
+   // returns DHT_STATE_DONE, getResult() tells whether the frame is valid and
+   // readTemperature()/readHumidity() decode it without touching the sensor
+   // again.  getResult(t, h) decodes both values and fails on NaN as well,
+   // e.g. a frame of a layout DHT_AUTO has not detected yet.
+   // clearResult() returns the driver to DHT_STATE_IDLE.
+   // canCapture() tells whether the pin supports it at all, startRead()
+   // always fails when it does not.
+   bool canCapture(void);
+   bool startRead(bool force=false);
+   uint8_t poll(void);
+   bool getResult(void);
+   uint8_t getType(void);
+   bool getResult(float &t, float &h, bool S=false);
+   void clearResult(void);
+
+   void getStats(dht_stats_t *stats);
+   void clearStats(void);
+   #ifdef DHT_USE_INPUT_CAPTURE
+     // Called from TIMER1_CAPT_vect.
+     static void captureISR(void);
+   #endif
 
  private:
   uint8_t data[5];
@@ -54,10 +147,46 @@ class DHT {
     // for the digital pin connected to the DHT.  Other platforms will use digitalRead.
     uint8_t _bit, _port;
   #endif
-  uint32_t _lastreadtime, _maxcycles;
+  uint32_t _lastreadtime;
+  dht_count_t _maxcycles;
   bool _lastresult;
+  // DHT_AUTO: next start signal uses the DHT11 hold time, layout of the last
+  // valid frame and how many frames in a row had it
+  bool _startlong;
+  uint8_t _autotype, _autocount;
+
+  dht_stats_t _stats;
+  // loop count of the last 80 us preamble, calibrates interrupt-off time
+  dht_count_t _preamblecycles;
+
+  // Non-blocking acquisition state, the last four are shared with the ISR.
+  // _statetime is the millis() of the state change, except in
+  // DHT_STATE_START where the hold is timed with micros().  _released is
+  // false until the start signal ends, falls seen before it are stale.
+  uint8_t _state;
+  uint32_t _statetime, _acqstart;
+  volatile bool _released;
+  volatile uint8_t _falls;
+  volatile uint32_t _lastedge;
+  volatile uint16_t _lowtime;
+  #ifdef DHT_USE_INPUT_CAPTURE
+    uint8_t _savedtccr1a, _savedtccr1b, _savedtimsk1;
+  #endif
 
-  uint32_t expectPulse(bool level);
+  dht_count_t expectPulse(bool level, dht_count_t maxcycles);
+  uint16_t startTime(void);
+  uint8_t frameType(void);
+  void detectType(void);
+  float decodeTemperature(bool S);
+  float decodeHumidity(void);
+  bool checkFrame(void);
+  uint32_t irqOffTime(uint32_t busycycles);
+  void recordAcquisition(uint8_t result, uint32_t duration, uint32_t irqoff);
+  bool beginCapture(void);
+  void endCapture(void);
+  void handleEdge(bool level, uint16_t width);
+  static void edgeISR(void);
+  static DHT *_isrinstance;
 
 };
 
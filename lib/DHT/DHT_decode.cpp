@@ -0,0 +1,45 @@
+/* DHT library
+
+MIT license
+written by Adafruit Industries
+*/
+
+#include "DHT_decode.h"
+
+uint8_t dht_check_frame(const uint8_t *data) {
+  if (data[4] == ((data[0] + data[1] + data[2] + data[3]) & 0xFF)) {
+    return DHT_DECODE_OK;
+  }
+  return DHT_DECODE_CHECKSUM;
+}
+
+uint8_t dht_decode_frame(const uint32_t *widths, uint8_t *data) {
+  data[0] = data[1] = data[2] = data[3] = data[4] = 0;
+
+  for (uint8_t i=0; i<40; ++i) {
+    uint32_t lowWidth  = widths[2*i];
+    uint32_t highWidth = widths[2*i+1];
+    if ((lowWidth == 0) || (highWidth == 0)) {
+      return DHT_DECODE_TIMEOUT;
+    }
+    dht_decode_bit(data, i, lowWidth, highWidth);
+  }
+  return dht_check_frame(data);
+}
+
+uint8_t dht_classify_frame(const uint8_t *data) {
+  // DHT11: 0-100 %RH and 0-50 C (some parts go below 0 with bit 7 of the
+  // temperature fraction set), both fractions 0-9.
+  if ((data[0] >= 4) && (data[0] <= 100) && (data[1] <= 9) &&
+      (data[2] <= 80) && ((data[3] & 0x7F) <= 9)) {
+    return DHT_FRAME_DHT11;
+  }
+  // DHT22: 0-1000 tenths of %RH, -400 to 800 tenths of C with a sign bit.
+  uint16_t humidity = ((uint16_t)data[0] << 8) | data[1];
+  uint16_t temperature = ((uint16_t)(data[2] & 0x7F) << 8) | data[3];
+  if ((humidity <= 1000) &&
+      (temperature <= ((data[2] & 0x80) ? 400 : 800))) {
+    return DHT_FRAME_DHT22;
+  }
+  return DHT_FRAME_UNKNOWN;
+}
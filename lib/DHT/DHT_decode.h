@@ -0,0 +1,58 @@
+/* DHT library
+
+MIT license
+written by Adafruit Industries
+*/
+#ifndef DHT_DECODE_H
+#define DHT_DECODE_H
+
+// Pulse-train decoding for the DHT family, kept free of any Arduino or GPIO
+// dependency so it can be built and exercised on a host.
+//
+// A trace is the 80 pulse widths of one frame after the 80 us preamble: the
+// ~50 us low pulse and the following high pulse of each of the 40 bits, in
+// transmission order (low0, high0, low1, high1, ...).  Widths may be in any
+// unit as long as it is the same for the whole trace (loop counts, timer
+// ticks or microseconds); 0 means the pulse timed out.  Recorded traces are
+// stored as text, one frame per line, 80 unsigned integers separated by
+// whitespace; anything after a '#' is a comment.  test/host/dht_replay
+// replays such files and dht_trace_gen writes synthesized ones.
+
+#include <stdint.h>
+
+#define DHT_FRAME_PULSES 80
+
+// Result of decoding a frame.
+#define DHT_DECODE_OK 0
+#define DHT_DECODE_TIMEOUT 1   // a pulse in the trace timed out (width 0)
+#define DHT_DECODE_CHECKSUM 2  // 40 bits received but the checksum is wrong
+
+// Frame layout, see dht_classify_frame().
+#define DHT_FRAME_UNKNOWN 0
+#define DHT_FRAME_DHT11 11   // integral byte and fraction byte, bytes 1 and 3
+                             // are fractions (0-9)
+#define DHT_FRAME_DHT22 22   // 16-bit tenths, also DHT21/AM2301
+
+// Shift bit number index of the frame into data[].  The bit is a 1 when its
+// high pulse outlasted the ~50 us low pulse that precedes it.
+static inline void dht_decode_bit(uint8_t *data, uint8_t index,
+                                  uint32_t lowWidth, uint32_t highWidth) {
+  data[index/8] <<= 1;
+  if (highWidth > lowWidth) {
+    data[index/8] |= 1;
+  }
+}
+
+// Checksum of a decoded frame.
+uint8_t dht_check_frame(const uint8_t *data);
+
+// Decode a full trace into data[5] and check it.
+uint8_t dht_decode_frame(const uint32_t *widths, uint8_t *data);
+
+// Which frame layout a valid frame is in, from its contents.  The two are
+// told apart by the humidity: a DHT22 never sends more than 1000 tenths so
+// its first byte is at most 3, while a DHT11 sends whole percents there and
+// nothing below 4 %RH.  Values out of range for both give DHT_FRAME_UNKNOWN.
+uint8_t dht_classify_frame(const uint8_t *data);
+
+#endif
@@ -0,0 +1,136 @@
+/* DHT library
+
+MIT license
+written by Adafruit Industries
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "DHT_heat.h"
+
+// a if c else b, with integer masks: GCC does not turn selects between
+// floats into vector blends while it has to keep floating point traps, and
+// arithmetic selects (c * a + (1 - c) * b) are folded back into branches.
+static inline float select_f(bool c, float a, float b) {
+  uint32_t ua, ub, mask = -(uint32_t)c;
+  memcpy(&ua, &a, sizeof(ua));
+  memcpy(&ub, &b, sizeof(ub));
+  ua = (ua & mask) | (ub & ~mask);
+  memcpy(&a, &ua, sizeof(a));
+  return a;
+}
+
+// Square root of x >= 0.  sqrtf() has to set errno on a negative argument,
+// which keeps it out of vectorized loops unless built with -fno-math-errno;
+// on hosts use the reciprocal square root estimate refined by three Newton
+// steps instead (full float precision, sqrt(0) is 0).  AVR has no vector
+// unit, it keeps sqrtf().
+static inline float sqrt_nonneg(float x) {
+#ifdef __AVR
+  return sqrtf(x);
+#else
+  uint32_t i;
+  float y;
+  memcpy(&i, &x, sizeof(i));
+  i = 0x5F375A86 - (i >> 1);
+  memcpy(&y, &i, sizeof(y));
+  y = y * (1.5f - 0.5f * x * y * y);
+  y = y * (1.5f - 0.5f * x * y * y);
+  y = y * (1.5f - 0.5f * x * y * y);
+  return x * y;
+#endif
+}
+
+// AVR has no vector unit and every float operation is a software call, so
+// computing both forms costs more there than the branches it saves.  It keeps
+// the branchy kernel; DHT_HEAT_BRANCHES selects it elsewhere, e.g. to check
+// it on a host.  Both kernels give the same bits.
+#if defined(__AVR) && !defined(DHT_HEAT_BRANCHES)
+#define DHT_HEAT_BRANCHES
+#endif
+
+// Using both Rothfusz and Steadman's equations
+// http://www.wpc.ncep.noaa.gov/html/heatindex_equation.shtml
+#ifdef DHT_HEAT_BRANCHES
+static inline float heat_index_f(float t, float h) {
+  float hi = 0.5f * (t + 61.0f + ((t - 68.0f) * 1.2f) + (h * 0.094f));
+  if (!(hi > 79.0f)) {
+    return hi;
+  }
+
+  // Rothfusz regression grouped by powers of T, see below
+  float a0 = -42.379f + h * (10.14333127f + h * -0.05481717f);
+  float a1 = 2.04901523f + h * (-0.22475541f + h * 0.00085282f);
+  float a2 = -0.00683783f + h * (0.00122874f + h * -0.00000199f);
+  hi = a0 + t * (a1 + t * a2);
+
+  if ((h < 13.0f) && (t >= 80.0f) && (t <= 112.0f)) {
+    hi -= ((13.0f - h) * 0.25f) * sqrt_nonneg((17.0f - fabsf(t - 95.0f)) * 0.05882f);
+  } else if ((h > 85.0f) && (t >= 80.0f) && (t <= 87.0f)) {
+    hi += ((h - 85.0f) * 0.1f) * ((87.0f - t) * 0.2f);
+  }
+  return hi;
+}
+#else
+// Both forms and both Rothfusz adjustments are always computed and the result
+// is selected, so the batch loops have no branch in their body.
+static inline float heat_index_f(float t, float h) {
+  float simple = 0.5f * (t + 61.0f + ((t - 68.0f) * 1.2f) + (h * 0.094f));
+
+  // -42.379 + 2.04901523 T + 10.14333127 H - 0.22475541 TH
+  // - 0.00683783 T^2 - 0.05481717 H^2 + 0.00122874 T^2 H
+  // + 0.00085282 T H^2 - 0.00000199 T^2 H^2, grouped by powers of T.
+  float a0 = -42.379f + h * (10.14333127f + h * -0.05481717f);
+  float a1 = 2.04901523f + h * (-0.22475541f + h * 0.00085282f);
+  float a2 = -0.00683783f + h * (0.00122874f + h * -0.00000199f);
+  float hi = a0 + t * (a1 + t * a2);
+
+  // the square root argument is clamped, it is only used in 80..112 F
+  float dry = (17.0f - fabsf(t - 95.0f)) * 0.05882f;
+  dry = select_f(dry > 0.0f, dry, 0.0f);
+  float lowh = ((13.0f - h) * 0.25f) * sqrt_nonneg(dry);
+  float highh = ((h - 85.0f) * 0.1f) * ((87.0f - t) * 0.2f);
+
+  hi = select_f((h < 13.0f) & (t >= 80.0f) & (t <= 112.0f), hi - lowh, hi);
+  hi = select_f((h > 85.0f) & (t >= 80.0f) & (t <= 87.0f), hi + highh, hi);
+  return select_f(simple > 79.0f, hi, simple);
+}
+#endif
+
+float dht_heat_index_f(float temperature, float percentHumidity) {
+  return heat_index_f(temperature, percentHumidity);
+}
+
+float dht_heat_index(float temperature, float percentHumidity, bool isFahrenheit) {
+  if (isFahrenheit) {
+    return dht_heat_index_f(temperature, percentHumidity);
+  }
+  return dht_f_to_c(heat_index_f(dht_c_to_f(temperature), percentHumidity));
+}
+
+void dht_heat_index_batch(const float *temperature, const float *percentHumidity,
+                          float *out, size_t count, bool isFahrenheit) {
+  if (isFahrenheit) {
+    for (size_t i=0; i<count; ++i) {
+      out[i] = heat_index_f(temperature[i], percentHumidity[i]);
+    }
+  } else {
+    for (size_t i=0; i<count; ++i) {
+      out[i] = dht_f_to_c(heat_index_f(dht_c_to_f(temperature[i]),
+                                       percentHumidity[i]));
+    }
+  }
+}
+
+void dht_c_to_f_batch(const float *in, float *out, size_t count) {
+  for (size_t i=0; i<count; ++i) {
+    out[i] = dht_c_to_f(in[i]);
+  }
+}
+
+void dht_f_to_c_batch(const float *in, float *out, size_t count) {
+  for (size_t i=0; i<count; ++i) {
+    out[i] = dht_f_to_c(in[i]);
+  }
+}
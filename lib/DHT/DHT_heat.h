@@ -0,0 +1,54 @@
+/* DHT library
+
+MIT license
+written by Adafruit Industries
+*/
+#ifndef DHT_HEAT_H
+#define DHT_HEAT_H
+
+// Heat index and unit conversion kernels, free of any Arduino dependency so
+// the same code scores logged samples on a host.
+//
+// The Rothfusz regression is evaluated in Horner form (two nested polynomials
+// in humidity inside one in temperature) instead of the pow() terms of the
+// original formula.  Over -40..80 C and 0..100 %RH, on the 0.02 grid of
+// test/host/dht_heat_check, the result is within 0.00072 F (and 0.00047 C) of
+// the pow() formula evaluated in double, and within 0.0013 F of the same
+// formula evaluated in float with powf().  Where float rounding moves the
+// simple formula across its 79 F switch-over the result jumps to the other
+// form, as the original formula does.
+//
+// On hosts the kernel has no branch: both forms and both adjustments are
+// computed and the result is selected.  With g++ 12 -O3 on x86-64 the batch
+// loops below are vectorized (checked with -fopt-info-vec) and give the same
+// bits as the scalar functions; at -O2 GCC 12 leaves them scalar.  AVR builds
+// the branchy kernel (DHT_HEAT_BRANCHES), which gives the same bits, and the
+// batch loops are the scalar path in a loop.
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Heat index in Fahrenheit from a Fahrenheit temperature.
+float dht_heat_index_f(float temperature, float percentHumidity);
+
+// Heat index in the unit of the temperature.
+float dht_heat_index(float temperature, float percentHumidity, bool isFahrenheit);
+
+// out[i] = dht_heat_index(temperature[i], percentHumidity[i], isFahrenheit).
+// out may alias either input.
+void dht_heat_index_batch(const float *temperature, const float *percentHumidity,
+                          float *out, size_t count, bool isFahrenheit);
+
+// Unit conversion, same constants as DHT::convertCtoF and DHT::convertFtoC.
+static inline float dht_c_to_f(float c) {
+  return c * 1.8 + 32;
+}
+
+static inline float dht_f_to_c(float f) {
+  return (f - 32) * 0.55555;
+}
+
+void dht_c_to_f_batch(const float *in, float *out, size_t count);
+void dht_f_to_c_batch(const float *in, float *out, size_t count);
+
+#endif
@@ -0,0 +1,139 @@
+#include "DHTBus.h"
+
+#define SENSOR_NONE 0xFF
+
+// detail implementation
+// init class
+DHTBus::DHTBus(uint32_t period) {
+  this->period = (period < DHT_BUS_MIN_PERIOD) ? DHT_BUS_MIN_PERIOD : period;
+  sensor_count = 0;
+  sensor_active = SENSOR_NONE;
+  sensor_next = 0;
+  t_last_start = 0;
+  queue_head = queue_used = 0;
+  queue_dropped = 0;
+}
+
+/**
+ * add sensor to the bus. the bus only runs non blocking acquisitions, so the
+ * sensor pin must have an edge interrupt (DHT::canCapture).
+ * @method addSensor
+ * @param  sensor    dht sensor object
+ * @return           false if the bus is full or the pin has no interrupt
+ */
+bool DHTBus::addSensor(DHT *sensor) {
+  if ((sensor_count >= DHT_BUS_MAX_SENSORS) || !sensor->canCapture()) {
+    return false;
+  }
+  sensors[sensor_count++] = sensor;
+  return true;
+}
+
+/**
+ * init all sensor pin
+ * @method begin
+ */
+void DHTBus::begin(void) {
+  for (uint8_t i = 0; i < sensor_count; i++) {
+    sensors[i]->begin();
+  }
+  // first slot is due right away
+  t_last_start = millis() - slotInterval();
+}
+
+/**
+ * advance the bus, call it on every loop pass. at most one sensor is polled
+ * and at most one acquisition is started per call.
+ * @method update
+ */
+void DHTBus::update(void) {
+  if (sensor_count == 0) {
+    return;
+  }
+
+  // finish the running acquisition first, never overlap two
+  if (sensor_active != SENSOR_NONE) {
+    DHT *sensor = sensors[sensor_active];
+    if (sensor->poll() == DHT_STATE_DONE) {
+      float tempx, humx;
+      uint8_t sts_ok = sensor->getResult(tempx, humx);
+      sensor->clearResult();
+      push(sensor_active, sts_ok, tempx, humx);
+      sensor_active = SENSOR_NONE;
+    }
+    return;
+  }
+
+  // staggered start, each sensor gets one slot per period
+  uint32_t t_now = millis();
+  if (t_now - t_last_start >= slotInterval()) {
+    if (sensors[sensor_next]->startRead()) {
+      sensor_active = sensor_next;
+      t_last_start = t_now;
+    }
+    sensor_next = (sensor_next + 1) % sensor_count;
+  }
+}
+
+/**
+ * is an acquisition running, update() should then be called again within a
+ * few ms
+ * @method busy
+ */
+bool DHTBus::busy(void) { return sensor_active != SENSOR_NONE; }
+
+/**
+ * number of sample waiting in the queue
+ * @method available
+ */
+uint8_t DHTBus::available(void) { return queue_used; }
+
+/**
+ * pop the oldest sample
+ * @method read
+ * @param  sample   sample output
+ * @return          false if the queue is empty
+ */
+bool DHTBus::read(dht_bus_sample_t *sample) {
+  if (queue_used == 0) {
+    return false;
+  }
+  *sample = queue[queue_head];
+  queue_head = (queue_head + 1) % DHT_BUS_QUEUE_SIZE;
+  queue_used--;
+  return true;
+}
+
+/**
+ * number of sample overwritten because the queue was full
+ * @method dropped
+ */
+uint16_t DHTBus::dropped(void) { return queue_dropped; }
+
+/**
+ * time between two acquisition start
+ * @method slotInterval
+ */
+uint32_t DHTBus::slotInterval(void) {
+  return period / (sensor_count ? sensor_count : 1);
+}
+
+/**
+ * push sample to the queue, the oldest one is overwritten when full
+ * @method push
+ */
+void DHTBus::push(uint8_t sensor, uint8_t status_ok, float tempx, float humx) {
+  if (queue_used == DHT_BUS_QUEUE_SIZE) {
+    queue_head = (queue_head + 1) % DHT_BUS_QUEUE_SIZE;
+    queue_used--;
+    queue_dropped++;
+  }
+  dht_bus_sample_t *sample =
+      &queue[(queue_head + queue_used) % DHT_BUS_QUEUE_SIZE];
+  sample->sensor = sensor;
+  sample->status_ok = status_ok;
+  sample->temperature = tempx;
+  sample->humidity = humx;
+  sample->timestamp = millis();
+  queue_used++;
+}
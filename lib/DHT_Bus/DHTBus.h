@@ -0,0 +1,60 @@
+#ifndef DHTBUS_H
+#define DHTBUS_H
+
+#if ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include <DHT.h>
+
+// max sensor on one bus
+#ifndef DHT_BUS_MAX_SENSORS
+#define DHT_BUS_MAX_SENSORS 4
+#endif
+
+// sample queue size
+#ifndef DHT_BUS_QUEUE_SIZE
+#define DHT_BUS_QUEUE_SIZE 8
+#endif
+
+// minimum time between two reads of the same sensor
+#define DHT_BUS_MIN_PERIOD 2000
+
+// one sample from the bus
+typedef struct {
+  uint8_t sensor;
+  uint8_t status_ok;
+  float humidity, temperature;
+  uint32_t timestamp;
+} dht_bus_sample_t;
+
+// several dht sensors read one at a time, round robin, so only one
+// acquisition is ever in flight and each sensor is read once per period
+class DHTBus {
+public:
+  DHTBus(uint32_t period = 5000);
+  bool addSensor(DHT *sensor);
+  void begin(void);
+  void update(void);
+  bool busy(void);
+
+  uint8_t available(void);
+  bool read(dht_bus_sample_t *sample);
+  uint16_t dropped(void);
+
+private:
+  DHT *sensors[DHT_BUS_MAX_SENSORS];
+  uint8_t sensor_count, sensor_active, sensor_next;
+  uint32_t period, t_last_start;
+
+  dht_bus_sample_t queue[DHT_BUS_QUEUE_SIZE];
+  uint8_t queue_head, queue_used;
+  uint16_t queue_dropped;
+
+  uint32_t slotInterval(void);
+  void push(uint8_t sensor, uint8_t status_ok, float tempx, float humx);
+};
+
+#endif
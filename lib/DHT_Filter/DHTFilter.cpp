@@ -0,0 +1,139 @@
+#include "DHTFilter.h"
+
+// detail implementation
+// init class
+SensorFilter::SensorFilter(float max_step, float alpha) {
+  this->max_step = max_step;
+  this->alpha = alpha;
+  reset();
+}
+
+/**
+ * forget all sample
+ * @method reset
+ */
+void SensorFilter::reset(void) {
+  window_head = window_used = 0;
+  reject_count = 0;
+  last = ema = 0.0;
+}
+
+/**
+ * push a new raw sample
+ * @method update
+ * @param  x      raw sample
+ * @return        false if the sample was rejected as outlier or not finite
+ */
+bool SensorFilter::update(float x) {
+  // nan or inf would stay in the ema for good, it is not a step either
+  if (!isfinite(x)) {
+    return false;
+  }
+  if (window_used && (max_step > 0.0) && (fabs(x - last) > max_step)) {
+    // a single spike is dropped, a step that stays is a real change and
+    // restarts the filter from there
+    if (++reject_count < DHT_FILTER_MAX_REJECT) {
+      return false;
+    }
+    reset();
+  }
+  reject_count = 0;
+  last = x;
+
+  window[window_head] = x;
+  window_head = (window_head + 1) % DHT_FILTER_WINDOW;
+  if (window_used < DHT_FILTER_WINDOW) {
+    window_used++;
+  }
+
+  float m = median();
+  if ((window_used == 1) || (alpha >= 1.0)) {
+    ema = m;
+  } else {
+    ema += alpha * (m - ema);
+  }
+  return true;
+}
+
+/**
+ * filtered value
+ * @method value
+ */
+float SensorFilter::value(void) { return ema; }
+
+/**
+ * consecutive rejected sample so far
+ * @method rejected
+ */
+uint8_t SensorFilter::rejected(void) { return reject_count; }
+
+/**
+ * median of the filled part of the window, insertion sort on a copy
+ * @method median
+ */
+float SensorFilter::median(void) {
+  float sorted[DHT_FILTER_WINDOW];
+
+  for (uint8_t i = 0; i < window_used; i++) {
+    float x = window[i];
+    uint8_t j = i;
+    while ((j > 0) && (sorted[j - 1] > x)) {
+      sorted[j] = sorted[j - 1];
+      j--;
+    }
+    sorted[j] = x;
+  }
+  return sorted[window_used / 2];
+}
+
+// init class
+DHTFilter::DHTFilter(float temp_change, float hum_change)
+    : temperature(DHT_FILTER_TEMP_STEP, DHT_FILTER_TEMP_ALPHA),
+      humidity(DHT_FILTER_HUM_STEP, DHT_FILTER_HUM_ALPHA) {
+  this->temp_change = temp_change;
+  this->hum_change = hum_change;
+  used = false;
+}
+
+/**
+ * forget all sample
+ * @method reset
+ */
+void DHTFilter::reset(void) {
+  temperature.reset();
+  humidity.reset();
+  used = false;
+}
+
+/**
+ * filter a new sensor reading in place
+ * @method update
+ * @param  tempx  raw temperature, replaced by the filtered one
+ * @param  humx   raw humidity, replaced by the filtered one
+ * @return        true if the filtered value moved more than the change
+ *                threshold since the last time true was returned, false
+ *                for a reading with a non-finite value, which is dropped
+ *                whole and left as is until a first reading went through
+ */
+bool DHTFilter::update(float &tempx, float &humx) {
+  if (!isfinite(tempx) || !isfinite(humx)) {
+    if (used) {
+      tempx = temperature.value();
+      humx = humidity.value();
+    }
+    return false;
+  }
+  temperature.update(tempx);
+  humidity.update(humx);
+  tempx = temperature.value();
+  humx = humidity.value();
+
+  if (used && (fabs(tempx - temp_used) < temp_change) &&
+      (fabs(humx - hum_used) < hum_change)) {
+    return false;
+  }
+  temp_used = tempx;
+  hum_used = humx;
+  used = true;
+  return true;
+}
@@ -0,0 +1,67 @@
+#ifndef DHTFILTER_H
+#define DHTFILTER_H
+
+#if ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+// median window, odd
+#ifndef DHT_FILTER_WINDOW
+#define DHT_FILTER_WINDOW 5
+#endif
+
+// consecutive rejected sample before a step is taken as real
+#ifndef DHT_FILTER_MAX_REJECT
+#define DHT_FILTER_MAX_REJECT 3
+#endif
+
+// default limits, temperature in celcius, humidity in percent
+#define DHT_FILTER_TEMP_STEP 5.0
+#define DHT_FILTER_TEMP_ALPHA 0.5
+#define DHT_FILTER_TEMP_CHANGE 0.2
+#define DHT_FILTER_HUM_STEP 15.0
+#define DHT_FILTER_HUM_ALPHA 0.5
+#define DHT_FILTER_HUM_CHANGE 1.0
+
+// one channel: rate of change rejection, then median of the last
+// DHT_FILTER_WINDOW accepted sample, then ema. no allocation, the window
+// is a fixed ring buffer. a stage is skipped by giving max_step <= 0 or
+// alpha >= 1.
+class SensorFilter {
+public:
+  SensorFilter(float max_step, float alpha);
+  bool update(float x);
+  float value(void);
+  uint8_t rejected(void);
+  void reset(void);
+
+private:
+  float max_step, alpha;
+  float window[DHT_FILTER_WINDOW];
+  uint8_t window_head, window_used;
+  float last, ema;
+  uint8_t reject_count;
+
+  float median(void);
+};
+
+// temperature and humidity filter ahead of the fuzzy system, tells when the
+// filtered value moved enough to be worth a new fuzzy run
+class DHTFilter {
+public:
+  DHTFilter(float temp_change = DHT_FILTER_TEMP_CHANGE,
+            float hum_change = DHT_FILTER_HUM_CHANGE);
+  bool update(float &tempx, float &humx);
+  void reset(void);
+
+  SensorFilter temperature, humidity;
+
+private:
+  float temp_change, hum_change;
+  float temp_used, hum_used;
+  bool used;
+};
+
+#endif
@@ -4,35 +4,93 @@
 // dht library
 #include <DHT.h>
 
+// get_dht_data result
+#define DHT_DATA_PENDING 0
+#define DHT_DATA_OK 1
+#define DHT_DATA_ERROR 2
+
+// longest wait of wait_dht_data, in ms: the 2 s between reads plus one
+// acquisition
+#define DHT_DATA_WAIT_TIMEOUT 3000
+
 // dht22 data sensor struct
 typedef struct {
   uint8_t status_ok;
   float humidity, temperature;
+  // heat index in celcius, computed once per reading
+  float heat_index;
 } dht_data_t;
 
 // proto void func
 uint8_t get_dht_data(DHT *dht_obj, dht_data_t *dht_data_output);
+uint8_t wait_dht_data(DHT *dht_obj, dht_data_t *dht_data_output,
+                      uint32_t timeout_ms);
 
 /**
- * Get humidity and temperature from dht sensor object
+ * Get humidity and temperature from dht sensor object without blocking.
+ * Starts an acquisition when the sensor is idle and returns pending until the
+ * frame is complete, so call it on every loop pass until it returns a result.
+ * The sensor pin must have an edge interrupt (DHT::canCapture), the call
+ * fails right away otherwise.
  * @method get_dht_data
  * @param  dht_obj         DHT sensor object
- * @param  dht_data_output dht data output
- * @return                 0=error, 1=ok
+ * @param  dht_data_output dht data output, status_ok is cleared on error
+ * @return                 DHT_DATA_PENDING, DHT_DATA_OK or DHT_DATA_ERROR
  */
 uint8_t get_dht_data(DHT *dht_obj, dht_data_t *dht_data_output) {
-  float hum = dht_obj->readHumidity();
-  // Read temperature as Celsius (the default)
-  float tempx = dht_obj->readTemperature();
+  uint8_t state = dht_obj->poll();
+
+  if (state == DHT_STATE_IDLE) {
+    // no edge interrupt on the sensor pin, it would never complete
+    if (!dht_obj->canCapture()) {
+      dht_data_output->status_ok = 0;
+      return DHT_DATA_ERROR;
+    }
+    dht_obj->startRead();
+    return DHT_DATA_PENDING;
+  }
+  if (state != DHT_STATE_DONE) {
+    return DHT_DATA_PENDING;
+  }
+
+  // Both values come from the frame this acquisition just received
+  float hum, tempx;
+  uint8_t sts_ok = dht_obj->getResult(tempx, hum);
+  dht_obj->clearResult();
 
   // Check if any reads failed and exit early (to try again).
-  uint8_t sts_ok = (!isnan(hum) && !isnan(tempx));
+  sts_ok = sts_ok && !isnan(hum) && !isnan(tempx);
 
   if (sts_ok) {
     dht_data_output->humidity = hum;
     dht_data_output->temperature = tempx;
-    dht_data_output->status_ok = 1;
+    dht_data_output->heat_index = dht_heat_index(tempx, hum, false);
+  }
+  dht_data_output->status_ok = sts_ok;
+  return sts_ok ? DHT_DATA_OK : DHT_DATA_ERROR;
+}
+
+/**
+ * Blocking get_dht_data for sketches that have nothing else to do meanwhile.
+ * Gives up when no result came within the timeout, e.g. when startRead keeps
+ * being refused, instead of spinning forever.
+ * @method wait_dht_data
+ * @param  dht_obj         DHT sensor object
+ * @param  dht_data_output dht data output, status_ok is cleared on error
+ * @param  timeout_ms      longest wait, DHT_DATA_WAIT_TIMEOUT covers one read
+ * @return                 DHT_DATA_OK or DHT_DATA_ERROR
+ */
+uint8_t wait_dht_data(DHT *dht_obj, dht_data_t *dht_data_output,
+                      uint32_t timeout_ms) {
+  uint32_t t_start = millis();
+  uint8_t sts;
+
+  while ((sts = get_dht_data(dht_obj, dht_data_output)) == DHT_DATA_PENDING) {
+    if (millis() - t_start >= timeout_ms) {
+      dht_data_output->status_ok = 0;
+      return DHT_DATA_ERROR;
+    }
   }
-  return sts_ok;
+  return sts;
 }
 #endif
@@ -22,7 +22,12 @@
 #include "DS3231.h"
 
 // Include hardware-specific functions for the correct MCU
-#if defined(__AVR__)
+#if defined(DS3231_SIM)
+	#include "hardware/sim/HW_SIM.h"
+#elif defined(__AVR__)
+	#if defined(DS3231_ASYNC_TWI)
+		#include "hardware/avr/HW_AVR_async.h"
+	#endif
 	#include "hardware/avr/HW_AVR.h"
 #elif defined(__PIC32MX__)
   #include "hardware/pic32/HW_PIC32.h"
@@ -37,49 +42,67 @@
 #define REG_DATE	0x04
 #define REG_MON		0x05
 #define REG_YEAR	0x06
+#define REG_A1SEC	0x07
+#define REG_A1MIN	0x08
+#define REG_A1HOUR	0x09
+#define REG_A1DAY	0x0a
+#define REG_A2MIN	0x0b
+#define REG_A2HOUR	0x0c
+#define REG_A2DAY	0x0d
 #define REG_CON		0x0e
 #define REG_STATUS	0x0f
 #define REG_AGING	0x10
 #define REG_TEMPM	0x11
 #define REG_TEMPL	0x12
 
-#define SEC_1970_TO_2000 946684800
-
-static const uint8_t dim[] = { 31,28,31,30,31,30,31,31,30,31,30,31 };
-
 /* Public */
 
-Time::Time()
-{
-	this->year = 2014;
-	this->mon  = 1;
-	this->date = 1;
-	this->hour = 0;
-	this->min  = 0;
-	this->sec  = 0;
-	this->dow  = 3;
-}
-
 DS3231::DS3231(uint8_t data_pin, uint8_t sclk_pin)
 {
 	_sda_pin = data_pin;
 	_scl_pin = sclk_pin;
+#if defined(DS3231_ASYNC_TWI)
+	_asyncStatus = DS3231_TWI_ERROR;
+#endif
 }
 
 Time DS3231::getTime()
 {
-	Time t;
 	_burstRead();
-	t.sec	= _decode(_burstArray[0]);
-	t.min	= _decode(_burstArray[1]);
-	t.hour	= _decodeH(_burstArray[2]);
-	t.dow	= _burstArray[3];
-	t.date	= _decode(_burstArray[4]);
-	t.mon	= _decode(_burstArray[5]);
-	t.year	= _decodeY(_burstArray[6])+2000;
-	return t;
+	return _decodeTime(_burstArray);
 }
 
+#if defined(DS3231_ASYNC_TWI)
+bool DS3231::startGetTime(ds3231_callback_t callback)
+{
+	if (_asyncStatus == DS3231_TWI_PENDING)
+		return false;
+	return readRegistersAsync(REG_SEC, _asyncArray, 7, &_asyncStatus, callback);
+}
+
+bool DS3231::timeReady()
+{
+	return _asyncStatus == DS3231_TWI_OK;
+}
+
+Time DS3231::getAsyncTime()
+{
+	return _decodeTime(_asyncArray);
+}
+
+bool DS3231::startGetSnapshot(ds3231_callback_t callback)
+{
+	if (_asyncStatus == DS3231_TWI_PENDING)
+		return false;
+	return readRegistersAsync(REG_SEC, _asyncArray, DS3231_SNAPSHOT_SIZE, &_asyncStatus, callback);
+}
+
+void DS3231::getAsyncSnapshot(DS3231Snapshot *snap)
+{
+	_decodeSnapshot(_asyncArray, snap);
+}
+#endif
+
 void DS3231::setTime(uint8_t hour, uint8_t min, uint8_t sec)
 {
 	if (((hour>=0) && (hour<24)) && ((min>=0) && (min<60)) && ((sec>=0) && (sec<60)))
@@ -126,148 +149,14 @@ void DS3231::setDOW(uint8_t dow)
 
 char *DS3231::getTimeStr(uint8_t format)
 {
-	static char output[] = "xxxxxxxx";
-	Time t;
-	t=getTime();
-	if (t.hour<10)
-		output[0]=48;
-	else
-		output[0]=char((t.hour / 10)+48);
-	output[1]=char((t.hour % 10)+48);
-	output[2]=58;
-	if (t.min<10)
-		output[3]=48;
-	else
-		output[3]=char((t.min / 10)+48);
-	output[4]=char((t.min % 10)+48);
-	output[5]=58;
-	if (format==FORMAT_SHORT)
-		output[5]=0;
-	else
-	{
-	if (t.sec<10)
-		output[6]=48;
-	else
-		output[6]=char((t.sec / 10)+48);
-	output[7]=char((t.sec % 10)+48);
-	output[8]=0;
-	}
-	return (char*)&output;
+	static char output[DS3231_TIME_STR_SIZE];
+	return ds3231_format_time(getTime(), output, format);
 }
 
 char *DS3231::getDateStr(uint8_t slformat, uint8_t eformat, char divider)
 {
-	static char output[] = "xxxxxxxxxx";
-	int yr, offset;
-	Time t;
-	t=getTime();
-	switch (eformat)
-	{
-		case FORMAT_LITTLEENDIAN:
-			if (t.date<10)
-				output[0]=48;
-			else
-				output[0]=char((t.date / 10)+48);
-			output[1]=char((t.date % 10)+48);
-			output[2]=divider;
-			if (t.mon<10)
-				output[3]=48;
-			else
-				output[3]=char((t.mon / 10)+48);
-			output[4]=char((t.mon % 10)+48);
-			output[5]=divider;
-			if (slformat==FORMAT_SHORT)
-			{
-				yr=t.year-2000;
-				if (yr<10)
-					output[6]=48;
-				else
-					output[6]=char((yr / 10)+48);
-				output[7]=char((yr % 10)+48);
-				output[8]=0;
-			}
-			else
-			{
-				yr=t.year;
-				output[6]=char((yr / 1000)+48);
-				output[7]=char(((yr % 1000) / 100)+48);
-				output[8]=char(((yr % 100) / 10)+48);
-				output[9]=char((yr % 10)+48);
-				output[10]=0;
-			}
-			break;
-		case FORMAT_BIGENDIAN:
-			if (slformat==FORMAT_SHORT)
-				offset=0;
-			else
-				offset=2;
-			if (slformat==FORMAT_SHORT)
-			{
-				yr=t.year-2000;
-				if (yr<10)
-					output[0]=48;
-				else
-					output[0]=char((yr / 10)+48);
-				output[1]=char((yr % 10)+48);
-				output[2]=divider;
-			}
-			else
-			{
-				yr=t.year;
-				output[0]=char((yr / 1000)+48);
-				output[1]=char(((yr % 1000) / 100)+48);
-				output[2]=char(((yr % 100) / 10)+48);
-				output[3]=char((yr % 10)+48);
-				output[4]=divider;
-			}
-			if (t.mon<10)
-				output[3+offset]=48;
-			else
-				output[3+offset]=char((t.mon / 10)+48);
-			output[4+offset]=char((t.mon % 10)+48);
-			output[5+offset]=divider;
-			if (t.date<10)
-				output[6+offset]=48;
-			else
-				output[6+offset]=char((t.date / 10)+48);
-			output[7+offset]=char((t.date % 10)+48);
-			output[8+offset]=0;
-			break;
-		case FORMAT_MIDDLEENDIAN:
-			if (t.mon<10)
-				output[0]=48;
-			else
-				output[0]=char((t.mon / 10)+48);
-			output[1]=char((t.mon % 10)+48);
-			output[2]=divider;
-			if (t.date<10)
-				output[3]=48;
-			else
-				output[3]=char((t.date / 10)+48);
-			output[4]=char((t.date % 10)+48);
-			output[5]=divider;
-			if (slformat==FORMAT_SHORT)
-			{
-				yr=t.year-2000;
-				if (yr<10)
-					output[6]=48;
-				else
-					output[6]=char((yr / 10)+48);
-				output[7]=char((yr % 10)+48);
-				output[8]=0;
-			}
-			else
-			{
-				yr=t.year;
-				output[6]=char((yr / 1000)+48);
-				output[7]=char(((yr % 1000) / 100)+48);
-				output[8]=char(((yr % 100) / 10)+48);
-				output[9]=char((yr % 10)+48);
-				output[10]=0;
-			}
-			break;
-	}
-	return (char*)&output;
+	static char output[DS3231_DATE_STR_SIZE];
+	return ds3231_format_date(getTime(), output, slformat, eformat, divider);
 }
 
 char *DS3231::getDOWStr(uint8_t format)
@@ -298,19 +187,14 @@ char *DS3231::getMonthStr(uint8_t format)
 	return output;
 }
 
-long DS3231::getUnixTime(Time t)
+uint32_t DS3231::getUnixTime(Time t)
 {
-	uint16_t	dc;
-
-	dc = t.date;
-	for (uint8_t i = 0; i<(t.mon-1); i++)
-		dc += dim[i];
-	if ((t.mon > 2) && (((t.year-2000) % 4) == 0))
-		++dc;
-	dc = dc + (365 * (t.year-2000)) + (((t.year-2000) + 3) / 4) - 1;
-
-	return ((((((dc * 24L) + t.hour) * 60) + t.min) * 60) + t.sec) + SEC_1970_TO_2000;
+	return ds3231_unix_time(t);
+}
 
+Time DS3231::getTimeFromUnix(uint32_t t)
+{
+	return ds3231_time_from_unix(t);
 }
 
 void DS3231::enable32KHz(bool enable)
@@ -337,15 +221,71 @@ void DS3231::setSQWRate(int rate)
   _writeRegister(REG_CON, _reg);
 }
 
+void DS3231::setAlarm1(uint8_t mode, uint8_t day, uint8_t hour, uint8_t min, uint8_t sec)
+{
+	_writeRegister(REG_A1SEC, _encode(sec) | ((mode & 0x01) << 7));
+	_writeRegister(REG_A1MIN, _encode(min) | ((mode & 0x02) << 6));
+	_writeRegister(REG_A1HOUR, _encode(hour) | ((mode & 0x04) << 5));
+	_writeRegister(REG_A1DAY, _encode(day) | ((mode & 0x08) << 4) | ((mode & 0x10) << 2));
+}
+
+void DS3231::setAlarm2(uint8_t mode, uint8_t day, uint8_t hour, uint8_t min)
+{
+	_writeRegister(REG_A2MIN, _encode(min) | ((mode & 0x01) << 7));
+	_writeRegister(REG_A2HOUR, _encode(hour) | ((mode & 0x02) << 6));
+	_writeRegister(REG_A2DAY, _encode(day) | ((mode & 0x04) << 5) | ((mode & 0x10) << 2));
+}
+
+void DS3231::enableAlarm(uint8_t alarm, bool enable)
+{
+	uint8_t _bit = (alarm == ALARM_1) ? 0x01 : 0x02;
+	uint8_t _reg = _readRegister(REG_CON);
+	if (enable)
+		_reg |= _bit | (1 << 2);
+	else
+		_reg &= ~_bit;
+	_writeRegister(REG_CON, _reg);
+}
+
+bool DS3231::checkAlarm(uint8_t alarm)
+{
+	uint8_t _bit = (alarm == ALARM_1) ? 0x01 : 0x02;
+	return (_readRegister(REG_STATUS) & _bit) != 0;
+}
+
+void DS3231::clearAlarm(uint8_t alarm)
+{
+	uint8_t _bit = (alarm == ALARM_1) ? 0x01 : 0x02;
+	uint8_t _reg = _readRegister(REG_STATUS);
+	_reg &= ~_bit;
+	_writeRegister(REG_STATUS, _reg);
+}
+
 float DS3231::getTemp()
 {
 	uint8_t _msb = _readRegister(REG_TEMPM);
 	uint8_t _lsb = _readRegister(REG_TEMPL);
-	return (float)_msb + ((_lsb >> 6) * 0.25f);
+	return _decodeTemp(_msb, _lsb);
+}
+
+void DS3231::getSnapshot(DS3231Snapshot *snap)
+{
+	uint8_t raw[DS3231_SNAPSHOT_SIZE];
+	_readRegisters(REG_SEC, raw, DS3231_SNAPSHOT_SIZE);
+	_decodeSnapshot(raw, snap);
 }
 
 /* Private */
 
+#if !defined(__AVR__) && !defined(DS3231_SIM)
+// The ARM and PIC32 backends only burst the time registers, read the rest
+// one register at a time
+void DS3231::_readRegisters(uint8_t reg, uint8_t *buf, uint8_t len)
+{
+	for (uint8_t i=0; i<len; i++)
+		buf[i] = _readRegister(reg + i);
+}
+
 void	DS3231::_sendStart(byte addr)
 {
 	pinMode(_sda_pin, OUTPUT);
@@ -416,6 +356,38 @@ void DS3231::_writeByte(uint8_t value)
 	pinMode(_sda_pin, OUTPUT);
 	shiftOut(_sda_pin, _scl_pin, MSBFIRST, value);
 }
+#endif
+
+Time DS3231::_decodeTime(uint8_t *raw)
+{
+	Time t;
+	t.sec	= _decode(raw[0]);
+	t.min	= _decode(raw[1]);
+	t.hour	= _decodeH(raw[2]);
+	t.dow	= raw[3];
+	t.date	= _decode(raw[4]);
+	t.mon	= _decode(raw[5]);
+	t.year	= _decodeY(raw[6])+2000;
+	return t;
+}
+
+float DS3231::_decodeTemp(uint8_t msb, uint8_t lsb)
+{
+	// Two's complement, the upper two bits of lsb are quarters of a degree
+	return (float)(int8_t)msb + ((lsb >> 6) * 0.25f);
+}
+
+void DS3231::_decodeSnapshot(uint8_t *raw, DS3231Snapshot *snap)
+{
+	snap->time			= _decodeTime(raw);
+	snap->control		= raw[REG_CON];
+	snap->status		= raw[REG_STATUS];
+	snap->aging			= (int8_t)raw[REG_AGING];
+	snap->temperature	= _decodeTemp(raw[REG_TEMPM], raw[REG_TEMPL]);
+	snap->alarm1		= (raw[REG_STATUS] & 0x01) != 0;
+	snap->alarm2		= (raw[REG_STATUS] & 0x02) != 0;
+	snap->oscStopped	= (raw[REG_STATUS] & 0x80) != 0;
+}
 
 uint8_t	DS3231::_decode(uint8_t value)
 {
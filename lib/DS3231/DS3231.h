@@ -22,7 +22,9 @@
 #ifndef DS3231_h
 #define DS3231_h
 
-#if defined(__AVR__)
+#if defined(DS3231_SIM)
+	#include "hardware/sim/HW_SIM_defines.h"
+#elif defined(__AVR__)
 	#include "Arduino.h"
 	#include "hardware/avr/HW_AVR_defines.h"
 #elif defined(__PIC32MX__)
@@ -33,17 +35,12 @@
 	#include "hardware/arm/HW_ARM_defines.h"
 #endif
 
+#include "DS3231_time.h"
+
 #define DS3231_ADDR_R	0xD1
 #define DS3231_ADDR_W	0xD0
 #define DS3231_ADDR		0x68
 
-#define FORMAT_SHORT	1
-#define FORMAT_LONG		2
-
-#define FORMAT_LITTLEENDIAN	1
-#define FORMAT_BIGENDIAN	2
-#define FORMAT_MIDDLEENDIAN	3
-
 #define MONDAY		1
 #define TUESDAY		2
 #define WEDNESDAY	3
@@ -60,20 +57,52 @@
 #define OUTPUT_SQW		0
 #define OUTPUT_INT		1
 
-class Time
+// Registers 0x00 to 0x12 read in one burst by getSnapshot()
+#define DS3231_SNAPSHOT_SIZE	19
+
+struct DS3231Snapshot
 {
-public:
-	uint8_t		hour;
-	uint8_t		min;
-	uint8_t		sec;
-	uint8_t		date;
-	uint8_t		mon;
-	uint16_t	year;
-	uint8_t		dow;
-
-	Time();
+	Time		time;
+	uint8_t		control;
+	uint8_t		status;
+	int8_t		aging;
+	float		temperature;			// die temperature, 0.25 C steps, updated every 64 s
+	bool		alarm1;					// alarm flags from the status register
+	bool		alarm2;
+	bool		oscStopped;				// oscillator stopped, time is not valid
 };
 
+#define ALARM_1		1
+#define ALARM_2		2
+
+// Alarm match modes, the low bits are the AxMn mask bits of the alarm
+#define ALARM1_EVERY_SECOND		0x0F
+#define ALARM1_MATCH_SEC		0x0E
+#define ALARM1_MATCH_MIN_SEC	0x0C
+#define ALARM1_MATCH_HOUR_MIN_SEC	0x08
+#define ALARM1_MATCH_DATE		0x00
+#define ALARM1_MATCH_DOW		0x10
+
+#define ALARM2_EVERY_MINUTE		0x07
+#define ALARM2_MATCH_MIN		0x06
+#define ALARM2_MATCH_HOUR_MIN	0x04
+#define ALARM2_MATCH_DATE		0x00
+#define ALARM2_MATCH_DOW		0x10
+
+// Interrupt driven TWI transactions, AVR hardware TWI pins only
+#if defined(DS3231_ASYNC_TWI) && (!defined(__AVR__) || defined(DS3231_SIM))
+	#undef DS3231_ASYNC_TWI
+#endif
+#ifndef DS3231_TWI_QUEUE
+	#define DS3231_TWI_QUEUE	4
+#endif
+
+#define DS3231_TWI_OK		0
+#define DS3231_TWI_ERROR	1
+#define DS3231_TWI_PENDING	0xFF
+
+typedef void (*ds3231_callback_t)(uint8_t status);
+
 class DS3231
 {
 	public:
@@ -89,18 +118,55 @@ class DS3231
 		char	*getDateStr(uint8_t slformat=FORMAT_LONG, uint8_t eformat=FORMAT_LITTLEENDIAN, char divider='.');
 		char	*getDOWStr(uint8_t format=FORMAT_LONG);
 		char	*getMonthStr(uint8_t format=FORMAT_LONG);
-		long	getUnixTime(Time t);
+		uint32_t	getUnixTime(Time t);
+		Time	getTimeFromUnix(uint32_t t);
 
 		void	enable32KHz(bool enable);
 		void	setOutput(byte enable);
 		void	setSQWRate(int rate);
 		float	getTemp();
+		void	getSnapshot(DS3231Snapshot *snap);
+
+		// day is the date or, with ALARMx_MATCH_DOW, the day of week
+		void	setAlarm1(uint8_t mode, uint8_t day, uint8_t hour, uint8_t min, uint8_t sec);
+		void	setAlarm2(uint8_t mode, uint8_t day, uint8_t hour, uint8_t min);
+		// Route the alarm to the INT/SQW pin (active low), this turns the
+		// square wave off
+		void	enableAlarm(uint8_t alarm, bool enable);
+		bool	checkAlarm(uint8_t alarm);
+		void	clearAlarm(uint8_t alarm);
+
+#if defined(DS3231_ASYNC_TWI)
+		// Queue a register read/write, returns false if the queue is full or
+		// the bit-banged bus is used.  buf must stay valid until status leaves
+		// DS3231_TWI_PENDING; callback runs in interrupt context.
+		bool	readRegistersAsync(uint8_t reg, uint8_t *buf, uint8_t len, volatile uint8_t *status=NULL, ds3231_callback_t callback=NULL);
+		bool	writeRegistersAsync(uint8_t reg, uint8_t *buf, uint8_t len, volatile uint8_t *status=NULL, ds3231_callback_t callback=NULL);
+		bool	asyncBusy();
+		// Start reading the time, getAsyncTime() decodes it once timeReady()
+		bool	startGetTime(ds3231_callback_t callback=NULL);
+		bool	timeReady();
+		Time	getAsyncTime();
+		// Same for a full snapshot, timeReady() tells when it is done
+		bool	startGetSnapshot(ds3231_callback_t callback=NULL);
+		void	getAsyncSnapshot(DS3231Snapshot *snap);
+#endif
 
 	private:
 		uint8_t _scl_pin;
 		uint8_t _sda_pin;
 		uint8_t _burstArray[7];
+#if defined(DS3231_ASYNC_TWI)
+		uint8_t _asyncArray[DS3231_SNAPSHOT_SIZE];
+		volatile uint8_t _asyncStatus;
+#endif
 		boolean	_use_hw;
+#if defined(__AVR__) && !defined(DS3231_SIM)
+		// Software I2C pins, port registers cached in begin()
+		volatile uint8_t *_sda_ddr, *_sda_out, *_sda_in;
+		volatile uint8_t *_scl_out;
+		uint8_t	_sda_bit, _scl_bit;
+#endif
 
 		void	_sendStart(byte addr);
 		void	_sendStop();
@@ -110,12 +176,16 @@ class DS3231
 		uint8_t	_readByte();
 		void	_writeByte(uint8_t value);
 		void	_burstRead();
+		void	_readRegisters(uint8_t reg, uint8_t *buf, uint8_t len);
 		uint8_t	_readRegister(uint8_t reg);
 		void 	_writeRegister(uint8_t reg, uint8_t value);
 		uint8_t	_decode(uint8_t value);
 		uint8_t	_decodeH(uint8_t value);
 		uint8_t	_decodeY(uint8_t value);
 		uint8_t	_encode(uint8_t vaule);
+		Time	_decodeTime(uint8_t *raw);
+		float	_decodeTemp(uint8_t msb, uint8_t lsb);
+		void	_decodeSnapshot(uint8_t *raw, DS3231Snapshot *snap);
 #if defined(__arm__)
 		Twi		*twi;
 #endif
@@ -0,0 +1,183 @@
+/*
+  DS3231_time.cpp - Time record and Unix time conversion for the DS3231 library
+  Copyright (C)2015 Rinky-Dink Electronics, Henning Karlsen. All right reserved
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the CC BY-NC-SA 3.0 license.
+  Please see the included documents for further information.
+*/
+#include "DS3231_time.h"
+
+#if defined(__AVR__)
+	#include <avr/pgmspace.h>
+#else
+	#define PROGMEM
+	#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#endif
+
+#define SEC_PER_DAY		86400UL
+
+// Days before the first of each month in a common year
+static const uint16_t cdm[] = { 0,31,59,90,120,151,181,212,243,273,304,334 };
+
+Time::Time()
+{
+	this->year = 2014;
+	this->mon  = 1;
+	this->date = 1;
+	this->hour = 0;
+	this->min  = 0;
+	this->sec  = 0;
+	this->dow  = 3;
+}
+
+// "00" to "99", two characters per entry
+static const char digits2[] PROGMEM =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+static bool _isLeap(uint16_t year)
+{
+	return ((year % 4) == 0) && (((year % 100) != 0) || ((year % 400) == 0));
+}
+
+uint32_t ds3231_unix_time(const Time &t)
+{
+	uint16_t	y = t.year - 2000;
+	uint8_t		mon = t.mon;
+	uint32_t	dc;
+
+	// A month read corrupt from the chip (0x00, 0xFF as 165) is clamped so
+	// that it never indexes past the table
+	if (mon < 1)
+		mon = 1;
+	else if (mon > 12)
+		mon = 12;
+
+	// Leap years from 2000 up to the year before this one
+	dc = (365UL * y) + ((y + 3) / 4) - ((y + 99) / 100) + ((y + 399) / 400);
+	dc += cdm[mon - 1] + t.date - 1;
+	if ((mon > 2) && _isLeap(t.year))
+		++dc;
+
+	return (((((dc * 24UL) + t.hour) * 60) + t.min) * 60) + t.sec + SEC_1970_TO_2000;
+}
+
+Time ds3231_time_from_unix(uint32_t t)
+{
+	Time		r;
+	uint32_t	days, secs;
+
+	if (t < SEC_1970_TO_2000)
+		t = SEC_1970_TO_2000;
+	t -= SEC_1970_TO_2000;
+	days = t / SEC_PER_DAY;
+	secs = t % SEC_PER_DAY;
+
+	r.hour = secs / 3600;
+	r.min  = (secs / 60) % 60;
+	r.sec  = secs % 60;
+	// 2000-01-01 was a Saturday, MONDAY is 1
+	r.dow  = ((days + 5) % 7) + 1;
+
+	// Civil date from the day count, years starting in March so that the leap
+	// day is the last day of the year (H. Hinnant, chrono-compatible date
+	// algorithms).  Eras of 400 years start on 0000-03-01, 730425 days
+	// before 2000-01-01.
+	uint32_t	d   = days + 730425;
+	uint32_t	era = d / 146097;
+	uint32_t	doe = d - (era * 146097);
+	uint32_t	yoe = (doe - (doe / 1460) + (doe / 36524) - (doe / 146096)) / 365;
+	uint32_t	doy = doe - ((365 * yoe) + (yoe / 4) - (yoe / 100));
+	uint32_t	mp  = ((5 * doy) + 2) / 153;
+
+	r.date = doy - (((153 * mp) + 2) / 5) + 1;
+	r.mon  = (mp < 10) ? (mp + 3) : (mp - 9);
+	r.year = (era * 400) + yoe + ((r.mon <= 2) ? 1 : 0);
+	return r;
+}
+
+void ds3231_unix_time_batch(const Time *t, uint32_t *out, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		out[i] = ds3231_unix_time(t[i]);
+}
+
+void ds3231_time_from_unix_batch(const uint32_t *t, Time *out, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		out[i] = ds3231_time_from_unix(t[i]);
+}
+
+// Two digits of value, modulo 100 so that a field read corrupt from the
+// chip never indexes past the table
+static char *_put2(char *p, uint8_t value)
+{
+	value %= 100;
+	p[0] = pgm_read_byte(&digits2[value * 2]);
+	p[1] = pgm_read_byte(&digits2[(value * 2) + 1]);
+	return p + 2;
+}
+
+static char *_putYear(char *p, uint16_t year, uint8_t slformat)
+{
+	if (slformat != FORMAT_SHORT)
+		p = _put2(p, year / 100);
+	return _put2(p, year % 100);
+}
+
+char *ds3231_format_time(const Time &t, char *buf, uint8_t format)
+{
+	char *p = buf;
+
+	p = _put2(p, t.hour);
+	*p++ = ':';
+	p = _put2(p, t.min);
+	if (format != FORMAT_SHORT)
+	{
+		*p++ = ':';
+		p = _put2(p, t.sec);
+	}
+	*p = 0;
+	return buf;
+}
+
+char *ds3231_format_date(const Time &t, char *buf, uint8_t slformat, uint8_t eformat, char divider)
+{
+	char *p = buf;
+
+	switch (eformat)
+	{
+		case FORMAT_LITTLEENDIAN:
+			p = _put2(p, t.date);
+			*p++ = divider;
+			p = _put2(p, t.mon);
+			*p++ = divider;
+			p = _putYear(p, t.year, slformat);
+			break;
+		case FORMAT_BIGENDIAN:
+			p = _putYear(p, t.year, slformat);
+			*p++ = divider;
+			p = _put2(p, t.mon);
+			*p++ = divider;
+			p = _put2(p, t.date);
+			break;
+		case FORMAT_MIDDLEENDIAN:
+			p = _put2(p, t.mon);
+			*p++ = divider;
+			p = _put2(p, t.date);
+			*p++ = divider;
+			p = _putYear(p, t.year, slformat);
+			break;
+	}
+	*p = 0;
+	return buf;
+}
@@ -0,0 +1,60 @@
+/*
+  DS3231_time.h - Time record and Unix time conversion for the DS3231 library
+  Copyright (C)2015 Rinky-Dink Electronics, Henning Karlsen. All right reserved
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the CC BY-NC-SA 3.0 license.
+  Please see the included documents for further information.
+*/
+#ifndef DS3231_time_h
+#define DS3231_time_h
+
+// Kept free of any Arduino dependency so that stored Time records can be
+// converted on a host.  Conversions are constant time (cumulative days
+// table, Gregorian leap years) and valid from 2000 to 2105, where the Unix
+// time still fits in 32 bits.  ds3231_unix_time clamps a month out of 1..12.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SEC_1970_TO_2000 946684800UL
+
+#define FORMAT_SHORT	1
+#define FORMAT_LONG		2
+
+#define FORMAT_LITTLEENDIAN	1
+#define FORMAT_BIGENDIAN	2
+#define FORMAT_MIDDLEENDIAN	3
+
+// Buffer sizes for the long formats, terminating zero included
+#define DS3231_TIME_STR_SIZE	9
+#define DS3231_DATE_STR_SIZE	11
+
+class Time
+{
+public:
+	uint8_t		hour;
+	uint8_t		min;
+	uint8_t		sec;
+	uint8_t		date;
+	uint8_t		mon;
+	uint16_t	year;
+	uint8_t		dow;
+
+	Time();
+};
+
+uint32_t	ds3231_unix_time(const Time &t);
+Time		ds3231_time_from_unix(uint32_t t);
+
+// out[i] = ds3231_unix_time(t[i]) and the inverse
+void		ds3231_unix_time_batch(const Time *t, uint32_t *out, size_t count);
+void		ds3231_time_from_unix_batch(const uint32_t *t, Time *out, size_t count);
+
+// Same text as DS3231::getTimeStr and getDateStr for an already read Time,
+// written to buf which is returned.  Every field takes two digits, a value
+// out of range is printed modulo 100.
+char		*ds3231_format_time(const Time &t, char *buf, uint8_t format=FORMAT_LONG);
+char		*ds3231_format_date(const Time &t, char *buf, uint8_t slformat=FORMAT_LONG, uint8_t eformat=FORMAT_LITTLEENDIAN, char divider='.');
+
+#endif
@@ -20,20 +20,135 @@ void DS3231::begin()
 	{
 		_use_hw = false;
 		pinMode(_scl_pin, OUTPUT);
+
+		// cache the port registers so each edge is a single register access
+		uint8_t port = digitalPinToPort(_sda_pin);
+		_sda_bit = digitalPinToBitMask(_sda_pin);
+		_sda_ddr = portModeRegister(port);
+		_sda_out = portOutputRegister(port);
+		_sda_in  = portInputRegister(port);
+		port = digitalPinToPort(_scl_pin);
+		_scl_bit = digitalPinToBitMask(_scl_pin);
+		_scl_out = portOutputRegister(port);
+	}
+}
+
+// *** Software I2C through direct port access ***
+// Same signalling as the generic digitalWrite version: SCL is always driven,
+// SDA is driven while the master sends and released (with pull-up) while
+// the slave does.  The port registers are shared with other pins, so every
+// access is done with interrupts off.
+
+#define SDA_OUTPUT()	{ uint8_t sreg = SREG; cli(); *_sda_ddr |= _sda_bit; SREG = sreg; }
+#define SDA_INPUT()		{ uint8_t sreg = SREG; cli(); *_sda_ddr &= ~_sda_bit; *_sda_out |= _sda_bit; SREG = sreg; }
+#define SDA_HIGH()		{ uint8_t sreg = SREG; cli(); *_sda_out |= _sda_bit; SREG = sreg; }
+#define SDA_LOW()		{ uint8_t sreg = SREG; cli(); *_sda_out &= ~_sda_bit; SREG = sreg; }
+#define SDA_READ()		((*_sda_in & _sda_bit) != 0)
+#define SCL_HIGH()		{ uint8_t sreg = SREG; cli(); *_scl_out |= _scl_bit; SREG = sreg; delayMicroseconds(DS3231_SOFT_I2C_DELAY); }
+#define SCL_LOW()		{ uint8_t sreg = SREG; cli(); *_scl_out &= ~_scl_bit; SREG = sreg; delayMicroseconds(DS3231_SOFT_I2C_DELAY); }
+
+void	DS3231::_sendStart(byte addr)
+{
+	SDA_OUTPUT();
+	SDA_HIGH();
+	SCL_HIGH();
+	SDA_LOW();
+	SCL_LOW();
+	_writeByte(addr);
+}
+
+void	DS3231::_sendStop()
+{
+	SDA_OUTPUT();
+	SDA_LOW();
+	SCL_HIGH();
+	SDA_HIGH();
+	SDA_INPUT();
+}
+
+void	DS3231::_sendNack()
+{
+	SDA_OUTPUT();
+	SCL_LOW();
+	SDA_HIGH();
+	SCL_HIGH();
+	SCL_LOW();
+	SDA_INPUT();
+}
+
+void	DS3231::_sendAck()
+{
+	SDA_OUTPUT();
+	SCL_LOW();
+	SDA_LOW();
+	SCL_HIGH();
+	SCL_LOW();
+	SDA_INPUT();
+}
+
+void	DS3231::_waitForAck()
+{
+	SDA_INPUT();
+	SCL_HIGH();
+	while (SDA_READ()) {}
+	SCL_LOW();
+}
+
+uint8_t DS3231::_readByte()
+{
+	SDA_INPUT();
+
+	uint8_t value = 0;
+
+	for (uint8_t i = 0; i < 8; ++i)
+	{
+		SCL_HIGH();
+		value <<= 1;
+		if (SDA_READ())
+			value |= 1;
+		SCL_LOW();
+	}
+	return value;
+}
+
+void DS3231::_writeByte(uint8_t value)
+{
+	SDA_OUTPUT();
+	for (uint8_t i = 0; i < 8; ++i)
+	{
+		if (value & 0x80)
+		{
+			SDA_HIGH();
+		}
+		else
+		{
+			SDA_LOW();
+		}
+		value <<= 1;
+		SCL_HIGH();
+		SCL_LOW();
 	}
 }
 
 void DS3231::_burstRead()
+{
+	_readRegisters(0, _burstArray, 7);
+}
+
+void DS3231::_readRegisters(uint8_t reg, uint8_t *buf, uint8_t len)
 {
 	if (_use_hw)
 	{
+#if defined(DS3231_ASYNC_TWI)
+		while (_twiBusy()) {};														// Let queued transactions finish
+#endif
 		// Send start address
 		TWCR = _BV(TWEN) | _BV(TWEA) | _BV(TWINT) | _BV(TWSTA);						// Send START
 		while ((TWCR & _BV(TWINT)) == 0) {};										// Wait for TWI to be ready
 		TWDR = DS3231_ADDR_W;
 		TWCR = _BV(TWEN) | _BV(TWINT) | _BV(TWEA);									// Clear TWINT to proceed
 		while ((TWCR & _BV(TWINT)) == 0) {};										// Wait for TWI to be ready
-		TWDR = 0;
+		TWDR = reg;
 		TWCR = _BV(TWEN) | _BV(TWINT) | _BV(TWEA);									// Clear TWINT to proceed
 		while ((TWCR & _BV(TWINT)) == 0) {};										// Wait for TWI to be ready
 
@@ -43,11 +158,11 @@ void DS3231::_burstRead()
 		TWDR = DS3231_ADDR_R;
 		TWCR = _BV(TWEN) | _BV(TWINT) | _BV(TWEA);									// Clear TWINT to proceed
 		while ((TWCR & _BV(TWINT)) == 0) {};										// Wait for TWI to be ready
-		for (int i=0; i<7; i++)
+		for (int i=0; i<len; i++)
 		{
 			TWCR = _BV(TWEN) | _BV(TWINT) | _BV(TWEA);								// Send ACK and clear TWINT to proceed
 			while ((TWCR & _BV(TWINT)) == 0) {};									// Wait for TWI to be ready
-			_burstArray[i] = TWDR;
+			buf[i] = TWDR;
 		}
 		TWCR = _BV(TWEN) | _BV(TWINT);												// Send NACK and clear TWINT to proceed
 		while ((TWCR & _BV(TWINT)) == 0) {};										// Wait for TWI to be ready
@@ -58,15 +173,15 @@ void DS3231::_burstRead()
 	{
 		_sendStart(DS3231_ADDR_W);
 		_waitForAck();
-		_writeByte(0);
+		_writeByte(reg);
 		_waitForAck();
 		_sendStart(DS3231_ADDR_R);
 		_waitForAck();
 
-		for (int i=0; i<7; i++)
+		for (int i=0; i<len; i++)
 		{
-			_burstArray[i] = _readByte();
-			if (i<6)
+			buf[i] = _readByte();
+			if (i<len-1)
 				_sendAck();
 			else
 				_sendNack();
@@ -81,6 +196,9 @@ uint8_t DS3231::_readRegister(uint8_t reg)
 
 	if (_use_hw)
 	{
+#if defined(DS3231_ASYNC_TWI)
+		while (_twiBusy()) {};														// Let queued transactions finish
+#endif
 		// Send start address
 		TWCR = _BV(TWEN) | _BV(TWEA) | _BV(TWINT) | _BV(TWSTA);						// Send START
 		while ((TWCR & _BV(TWINT)) == 0) {};										// Wait for TWI to be ready
@@ -124,6 +242,9 @@ void DS3231::_writeRegister(uint8_t reg, uint8_t value)
 {
 	if (_use_hw)
 	{
+#if defined(DS3231_ASYNC_TWI)
+		while (_twiBusy()) {};														// Let queued transactions finish
+#endif
 		// Send start address
 		TWCR = _BV(TWEN) | _BV(TWEA) | _BV(TWINT) | _BV(TWSTA);						// Send START
 		while ((TWCR & _BV(TWINT)) == 0) {};										// Wait for TWI to be ready
@@ -0,0 +1,162 @@
+// *** Interrupt driven TWI transactions (DS3231_ASYNC_TWI) ***
+//
+// Transactions are queued and run one after the other by the TWI interrupt,
+// each one is a register address write followed by a read or a write of
+// len bytes.  The status byte of a transaction is DS3231_TWI_PENDING until
+// it is done, then the callback (if any) runs from the interrupt.
+// This engine owns TWI_vect, so it can not be used together with Wire.
+
+// TWSR status codes, see util/twi.h
+#define TWI_START			0x08
+#define TWI_REP_START		0x10
+#define TWI_MT_SLA_ACK		0x18
+#define TWI_MT_DATA_ACK		0x28
+#define TWI_MR_SLA_ACK		0x40
+#define TWI_MR_DATA_ACK		0x50
+#define TWI_MR_DATA_NACK	0x58
+
+struct ds3231_twi_t
+{
+	uint8_t				reg;
+	uint8_t				*buf;
+	uint8_t				len;
+	bool				read;
+	volatile uint8_t	*status;
+	ds3231_callback_t	callback;
+};
+
+static ds3231_twi_t			_twiQueue[DS3231_TWI_QUEUE];
+static volatile uint8_t		_twiHead = 0;
+static volatile uint8_t		_twiUsed = 0;
+static volatile uint8_t		_twiIndex;
+
+static void _twiStart()
+{
+	// a STOP just sent is still on the bus for a few cycles
+	while (TWCR & _BV(TWSTO)) {};
+	_twiIndex = 0;
+	TWCR = _BV(TWEN) | _BV(TWIE) | _BV(TWINT) | _BV(TWSTA);						// Send START
+}
+
+static void _twiFinish(uint8_t status)
+{
+	TWCR = _BV(TWEN) | _BV(TWINT) | _BV(TWSTO);										// Send STOP, interrupt off
+
+	ds3231_twi_t *t = &_twiQueue[_twiHead];
+	ds3231_callback_t callback = t->callback;
+	if (t->status != NULL)
+		*t->status = status;
+	_twiHead = (_twiHead + 1) % DS3231_TWI_QUEUE;
+	_twiUsed--;
+
+	// the next transaction is on the bus before the callback can queue more
+	if (_twiUsed > 0)
+		_twiStart();
+	if (callback != NULL)
+		callback(status);
+}
+
+ISR(TWI_vect)
+{
+	ds3231_twi_t *t = &_twiQueue[_twiHead];
+
+	switch (TWSR & 0xF8)
+	{
+	case TWI_START:
+		TWDR = DS3231_ADDR_W;
+		TWCR = _BV(TWEN) | _BV(TWIE) | _BV(TWINT);
+		break;
+	case TWI_MT_SLA_ACK:
+		TWDR = t->reg;
+		TWCR = _BV(TWEN) | _BV(TWIE) | _BV(TWINT);
+		break;
+	case TWI_MT_DATA_ACK:
+		if (t->read)
+			TWCR = _BV(TWEN) | _BV(TWIE) | _BV(TWINT) | _BV(TWSTA);				// Send rep. START
+		else if (_twiIndex < t->len)
+		{
+			TWDR = t->buf[_twiIndex++];
+			TWCR = _BV(TWEN) | _BV(TWIE) | _BV(TWINT);
+		}
+		else
+			_twiFinish(DS3231_TWI_OK);
+		break;
+	case TWI_REP_START:
+		TWDR = DS3231_ADDR_R;
+		TWCR = _BV(TWEN) | _BV(TWIE) | _BV(TWINT);
+		break;
+	case TWI_MR_SLA_ACK:
+		// ACK every byte but the last one
+		if (t->len > 1)
+			TWCR = _BV(TWEN) | _BV(TWIE) | _BV(TWINT) | _BV(TWEA);
+		else
+			TWCR = _BV(TWEN) | _BV(TWIE) | _BV(TWINT);
+		break;
+	case TWI_MR_DATA_ACK:
+		t->buf[_twiIndex++] = TWDR;
+		if (_twiIndex < (t->len - 1))
+			TWCR = _BV(TWEN) | _BV(TWIE) | _BV(TWINT) | _BV(TWEA);
+		else
+			TWCR = _BV(TWEN) | _BV(TWIE) | _BV(TWINT);
+		break;
+	case TWI_MR_DATA_NACK:
+		t->buf[_twiIndex++] = TWDR;
+		_twiFinish(DS3231_TWI_OK);
+		break;
+	default:
+		// address or data not acknowledged, arbitration lost or bus error
+		_twiFinish(DS3231_TWI_ERROR);
+		break;
+	}
+}
+
+static bool _twiQueueTransaction(uint8_t reg, uint8_t *buf, uint8_t len, bool read, volatile uint8_t *status, ds3231_callback_t callback)
+{
+	if (len == 0)
+		return false;
+
+	uint8_t sreg = SREG;
+	cli();
+	if (_twiUsed >= DS3231_TWI_QUEUE)
+	{
+		SREG = sreg;
+		return false;
+	}
+	ds3231_twi_t *t = &_twiQueue[(_twiHead + _twiUsed) % DS3231_TWI_QUEUE];
+	t->reg = reg;
+	t->buf = buf;
+	t->len = len;
+	t->read = read;
+	t->status = status;
+	t->callback = callback;
+	if (status != NULL)
+		*status = DS3231_TWI_PENDING;
+	if (_twiUsed++ == 0)
+		_twiStart();
+	SREG = sreg;
+	return true;
+}
+
+static bool _twiBusy()
+{
+	return _twiUsed > 0;
+}
+
+bool DS3231::readRegistersAsync(uint8_t reg, uint8_t *buf, uint8_t len, volatile uint8_t *status, ds3231_callback_t callback)
+{
+	if (!_use_hw)
+		return false;
+	return _twiQueueTransaction(reg, buf, len, true, status, callback);
+}
+
+bool DS3231::writeRegistersAsync(uint8_t reg, uint8_t *buf, uint8_t len, volatile uint8_t *status, ds3231_callback_t callback)
+{
+	if (!_use_hw)
+		return false;
+	return _twiQueueTransaction(reg, buf, len, false, status, callback);
+}
+
+bool DS3231::asyncBusy()
+{
+	return _twiBusy();
+}
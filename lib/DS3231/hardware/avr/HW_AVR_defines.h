@@ -4,3 +4,9 @@
 #ifndef TWI_FREQ
 	#define TWI_FREQ 400000L
 #endif
+
+// Half clock period of the software I2C in microseconds, 1 gives roughly
+// 300 kHz on a 16 MHz AVR
+#ifndef DS3231_SOFT_I2C_DELAY
+	#define DS3231_SOFT_I2C_DELAY 1
+#endif
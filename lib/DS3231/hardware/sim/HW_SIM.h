@@ -0,0 +1,182 @@
+// *** Simulated DS3231 for host builds (DS3231_SIM) ***
+
+#define SIM_REGS		0x13
+#define SIM_REG_CON		0x0e
+#define SIM_REG_STATUS	0x0f
+
+static uint8_t	_simRegs[SIM_REGS] = { 0x00,0x00,0x00,0x06,0x01,0x01,0x00,	// 2000-01-01, Saturday
+									   0,0,0,0, 0,0,0,
+									   0x1C, 0x88, 0, 0x19, 0x00 };		// power on control and status, 25 C
+static uint16_t	_simMillis = 0;
+static uint32_t	_simTransfers = 0;
+
+static uint8_t _simBcd(uint8_t value)
+{
+	return ((value / 10) << 4) + (value % 10);
+}
+
+static uint8_t _simDec(uint8_t value)
+{
+	return ((value >> 4) * 10) + (value & 0x0F);
+}
+
+static Time _simTime()
+{
+	Time t;
+	t.sec	= _simDec(_simRegs[0] & 0x7F);
+	t.min	= _simDec(_simRegs[1] & 0x7F);
+	t.hour	= _simDec(_simRegs[2] & 0x3F);
+	t.dow	= _simRegs[3] & 0x07;
+	t.date	= _simDec(_simRegs[4] & 0x3F);
+	t.mon	= _simDec(_simRegs[5] & 0x1F);
+	t.year	= _simDec(_simRegs[6]) + 2000;
+	return t;
+}
+
+static void _simSetTime(const Time &t, bool withDow)
+{
+	_simRegs[0] = _simBcd(t.sec);
+	_simRegs[1] = _simBcd(t.min);
+	_simRegs[2] = _simBcd(t.hour);
+	if (withDow)
+		_simRegs[3] = t.dow;
+	_simRegs[4] = _simBcd(t.date);
+	_simRegs[5] = _simBcd(t.mon);
+	_simRegs[6] = _simBcd(t.year % 100);
+}
+
+// Does an alarm match the current time, regs points to its seconds (Alarm1)
+// or minutes (Alarm2) register
+static bool _simAlarmMatch(const uint8_t *regs, bool hasSeconds)
+{
+	uint8_t	mask = 0;
+	uint8_t	n = hasSeconds ? 4 : 3;
+	for (uint8_t i = 0; i < n; i++)
+		mask |= ((regs[i] >> 7) & 1) << i;
+	uint8_t	day = regs[n - 1];
+	const uint8_t *now = hasSeconds ? &_simRegs[0] : &_simRegs[1];
+
+	// Alarm2 fires at the top of the minute
+	if (!hasSeconds && (_simRegs[0] != 0))
+		return false;
+	if (mask == ((1 << n) - 1))
+		return true;
+	for (uint8_t i = 0; i < n - 1; i++)
+	{
+		if ((mask >> i) & 1)
+			return true;
+		if ((regs[i] & 0x7F) != (now[i] & 0x7F))
+			return false;
+	}
+	if ((mask >> (n - 1)) & 1)
+		return true;
+	if (day & 0x40)
+		return (day & 0x0F) == _simRegs[3];
+	return (day & 0x3F) == _simRegs[4];
+}
+
+static void _simTick()
+{
+	Time	t = _simTime();
+	uint8_t	hour = t.hour;
+	t = ds3231_time_from_unix(ds3231_unix_time(t) + 1);
+	_simSetTime(t, false);
+	// the day of week register is a free running 1 to 7 counter
+	if (hour == 23 && t.hour == 0)
+		_simRegs[3] = (_simRegs[3] % 7) + 1;
+
+	if (_simAlarmMatch(&_simRegs[0x07], true))
+		_simRegs[SIM_REG_STATUS] |= 0x01;
+	if (_simAlarmMatch(&_simRegs[0x0b], false))
+		_simRegs[SIM_REG_STATUS] |= 0x02;
+}
+
+void ds3231_sim_set_unix(uint32_t t)
+{
+	_simSetTime(ds3231_time_from_unix(t), true);
+	_simMillis = 0;
+}
+
+void ds3231_sim_advance(uint32_t ms)
+{
+	ms += _simMillis;
+	while (ms >= 1000)
+	{
+		_simTick();
+		ms -= 1000;
+	}
+	_simMillis = ms;
+}
+
+uint32_t ds3231_sim_unix()
+{
+	return ds3231_unix_time(_simTime());
+}
+
+bool ds3231_sim_int()
+{
+	uint8_t con = _simRegs[SIM_REG_CON];
+	if ((con & 0x04) == 0)
+		return false;
+	return (_simRegs[SIM_REG_STATUS] & con & 0x03) != 0;
+}
+
+void ds3231_sim_set_temp(float celsius)
+{
+	int16_t quarters = (int16_t)(celsius * 4.0f);
+	_simRegs[0x11] = (uint8_t)(quarters >> 2);
+	_simRegs[0x12] = (uint8_t)((quarters & 0x03) << 6);
+}
+
+uint32_t ds3231_sim_transfers()
+{
+	return _simTransfers;
+}
+
+void DS3231::begin()
+{
+	_use_hw = true;
+}
+
+void DS3231::_burstRead()
+{
+	_readRegisters(0, _burstArray, 7);
+}
+
+void DS3231::_readRegisters(uint8_t reg, uint8_t *buf, uint8_t len)
+{
+	for (uint8_t i = 0; i < len; i++)
+		buf[i] = _readRegister(reg + i);
+}
+
+uint8_t DS3231::_readRegister(uint8_t reg)
+{
+	_simTransfers++;
+	if (reg >= SIM_REGS)
+		return 0;
+	return _simRegs[reg];
+}
+
+void DS3231::_writeRegister(uint8_t reg, uint8_t value)
+{
+	_simTransfers++;
+	if (reg >= SIM_REGS)
+		return;
+	switch (reg)
+	{
+		case SIM_REG_STATUS:
+			// flags can only be cleared, BSY is read only
+			_simRegs[reg] = (_simRegs[reg] & value & 0x83) | (value & 0x08);
+			break;
+		case 0x11:
+		case 0x12:
+			// temperature is read only
+			break;
+		default:
+			_simRegs[reg] = value;
+			// writing the seconds restarts the countdown chain
+			if (reg == 0)
+				_simMillis = 0;
+			break;
+	}
+}
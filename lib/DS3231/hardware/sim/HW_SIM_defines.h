@@ -0,0 +1,34 @@
+// *** Simulated DS3231 for host builds (DS3231_SIM) ***
+//
+// The register map (time, alarms, control, status, aging, temperature) lives
+// in memory and runs on a virtual clock that only moves when
+// ds3231_sim_advance() is called, so days of RTC time can be run through the
+// normal DS3231 API in a fraction of a second.  Only the 24 hour mode is
+// simulated and the century bit is not kept.
+
+#include <stdint.h>
+#include <stddef.h>
+
+#if defined(ARDUINO)
+	#include "Arduino.h"
+#else
+	typedef uint8_t	byte;
+	typedef bool	boolean;
+#endif
+
+#define SDA		0
+#define SCL		1
+
+// Set the clock registers from a Unix time, the day of week follows it
+void		ds3231_sim_set_unix(uint32_t t);
+// Move the virtual clock forward, alarm flags are set on every second passed
+void		ds3231_sim_advance(uint32_t ms);
+// Unix time of the registers
+uint32_t	ds3231_sim_unix();
+// Level of the INT/SQW output: true while an enabled alarm is pending
+// (the pin is low)
+bool		ds3231_sim_int();
+// Die temperature reported in registers 0x11 and 0x12
+void		ds3231_sim_set_temp(float celsius);
+// Count of register reads and writes since the start, one per byte
+uint32_t	ds3231_sim_transfers();
@@ -13,20 +13,28 @@
 
 // CONSTRUTORES
 Fuzzy::Fuzzy(){
-    // Iniciando os ponteiros como nulo
-    // FuzzyInput
-    this->fuzzyInputs       = NULL;
-    this->fuzzyInputsCursor = NULL;
-    // FuzzyOutput
-    this->fuzzyOutputs          = NULL;
-    this->fuzzyOutputsCursor    = NULL;
-    // FuzzyRule
-    this->fuzzyRules        = NULL;
-    this->fuzzyRulesCursor  = NULL;
+    this->init();
+}
+
+Fuzzy::Fuzzy(void* buffer, size_t bufferSize, const fuzzyModelSize* modelSize){
+    this->init();
+
+    fuzzyMemRequirements req = Fuzzy::sizeOf(modelSize);
+    if(bufferSize < req.arenaBytes || !fuzzyArenaInit(&this->arena, buffer, req.modelBytes, req.scratchBytes, sizeof(pointsArray))){
+        this->failed = true;
+        return;
+    }
+    this->ownsArena = true;
 }
 
 // DESTRUTOR
 Fuzzy::~Fuzzy(){
+    // Os pontos das composições voltam para a arena enquanto ela existe
+    fuzzyOutputArray* aux = this->ownsArena ? this->fuzzyOutputs : NULL;
+    while(aux != NULL){
+        aux->fuzzyOutput->release();
+        aux = aux->next;
+    }
     this->cleanFuzzyInputs(this->fuzzyInputs);
     this->cleanFuzzyOutputs(this->fuzzyOutputs);
     this->cleanFuzzyRules(this->fuzzyRules);
@@ -37,7 +45,9 @@ bool Fuzzy::addFuzzyInput(FuzzyInput* fuzzyInput){
     fuzzyInputArray* aux;
     
     // Alocando espaço na memória
-    if((aux = (fuzzyInputArray *) malloc(sizeof(fuzzyInputArray))) == NULL){
+    // Um objeto de outra arena (ou do heap) sairia do orçamento deste Fuzzy
+    if(this->failed || fuzzyInput->getArena() != this->getArena() || (aux = (fuzzyInputArray *) fuzzyMalloc(this->getArena(), sizeof(fuzzyInputArray))) == NULL){
+        this->failed = true;
         return false;
     }
 
@@ -58,7 +68,9 @@ bool Fuzzy::addFuzzyInput(FuzzyInput* fuzzyInput){
 bool Fuzzy::addFuzzyOutput(FuzzyOutput* fuzzyOutput){
     fuzzyOutputArray *aux;
     // Alocando espaço na memória
-    if((aux = (fuzzyOutputArray *) malloc(sizeof(fuzzyOutputArray))) == NULL){
+    // Um objeto de outra arena (ou do heap) sairia do orçamento deste Fuzzy
+    if(this->failed || fuzzyOutput->getArena() != this->getArena() || (aux = (fuzzyOutputArray *) fuzzyMalloc(this->getArena(), sizeof(fuzzyOutputArray))) == NULL){
+        this->failed = true;
         return false;
     }
     aux->fuzzyOutput = fuzzyOutput;
@@ -80,7 +92,9 @@ bool Fuzzy::addFuzzyOutput(FuzzyOutput* fuzzyOutput){
 bool Fuzzy::addFuzzyRule(FuzzyRule* fuzzyRule){
     fuzzyRuleArray* aux;
     // Alocando espaço na memória
-    if((aux = (fuzzyRuleArray *) malloc(sizeof(fuzzyRuleArray))) == NULL){
+    // Um objeto de outra arena (ou do heap) sairia do orçamento deste Fuzzy
+    if(this->failed || fuzzyRule->getArena() != this->getArena() || (aux = (fuzzyRuleArray *) fuzzyMalloc(this->getArena(), sizeof(fuzzyRuleArray))) == NULL){
+        this->failed = true;
         return false;
     }
     aux->fuzzyRule = fuzzyRule;
@@ -111,6 +125,13 @@ bool Fuzzy::setInput(int fuzzyInputIndex, float crispValue){
 }
 
 bool Fuzzy::fuzzify(){
+    if(!this->isValid()){
+        return false;
+    }
+#ifdef FUZZY_MEM_STATS
+    fuzzyMemStatsReset();
+    fuzzyStackPaint();
+#endif
     fuzzyInputArray* fuzzyInputAux;
 
     fuzzyOutputArray *fuzzyOutputAux;
@@ -143,13 +164,16 @@ bool Fuzzy::fuzzify(){
         fuzzyRuleAux = fuzzyRuleAux->next;
     }
 
-    // Truncado os conjuntos de saída
+    // Os conjuntos de saída só são truncados no defuzzify da saída
     fuzzyOutputAux = this->fuzzyOutputs;
     while(fuzzyOutputAux != NULL){
-        fuzzyOutputAux->fuzzyOutput->truncate();
+        fuzzyOutputAux->fuzzyOutput->invalidate();
         fuzzyOutputAux = fuzzyOutputAux->next;
     }
 
+#ifdef FUZZY_MEM_STATS
+    fuzzyMemStatsGet(&this->fuzzifyMemStats);
+#endif
     return true;
 }
 
@@ -165,39 +189,184 @@ bool Fuzzy::isFiredRule(int fuzzyRuleIndex){
     return false;
 }
 
+// Preenche fuzzyRuleIndexes com os índices das regras disparadas, na ordem
+// em que foram adicionadas, e retorna o total de regras disparadas (mesmo que
+// maior que maxCount). Permite comparar o conjunto de regras disparadas entre
+// duas implementações sem consultar isFiredRule regra a regra.
+int Fuzzy::getFiredRules(int* fuzzyRuleIndexes, int maxCount){
+    fuzzyRuleArray *aux;
+    int count = 0;
+    aux = this->fuzzyRules;
+    while(aux != NULL){
+        if(aux->fuzzyRule->isFired()){
+            if(fuzzyRuleIndexes != NULL && count < maxCount){
+                fuzzyRuleIndexes[count] = aux->fuzzyRule->getIndex();
+            }
+            count++;
+        }
+        aux = aux->next;
+    }
+    return count;
+}
+
 float Fuzzy::defuzzify(int fuzzyOutputIndex){
+#ifdef FUZZY_MEM_STATS
+    fuzzyMemStatsReset();
+    fuzzyStackPaint();
+#endif
     fuzzyOutputArray *aux;
+    float crispOutput = 0;
     aux = this->fuzzyOutputs;
     while(aux != NULL){
         if(aux->fuzzyOutput->getIndex() == fuzzyOutputIndex){
-            return aux->fuzzyOutput->getCrispOutput();
+            fuzzyScratchReset(this->getArena());
+            crispOutput = aux->fuzzyOutput->getCrispOutput();
+            // Sem blocos de scratch suficientes a composição ficou incompleta
+            if(fuzzyScratchFailed(this->getArena())){
+                aux->fuzzyOutput->invalidate();
+                crispOutput = 0;
+            }
+            break;
         }
         aux = aux->next;
     }
-    return 0;
+#ifdef FUZZY_MEM_STATS
+    fuzzyMemStatsGet(&this->defuzzifyMemStats);
+#endif
+    return crispOutput;
+}
+
+bool Fuzzy::isValid(){
+    return !this->failed && !fuzzyArenaFailed(this->getArena());
+}
+
+fuzzyArena* Fuzzy::getArena(){
+    return this->ownsArena ? &this->arena : NULL;
+}
+
+fuzzyMemRequirements Fuzzy::sizeOf(const fuzzyModelSize* modelSize){
+    fuzzyMemRequirements req;
+    size_t consequentSets = modelSize->consequentSets > 0 ? modelSize->consequentSets : modelSize->rules;
+
+    req.modelBytes = modelSize->inputs * fuzzyArenaAlign(sizeof(fuzzyInputArray))
+                   + modelSize->outputs * fuzzyArenaAlign(sizeof(fuzzyOutputArray))
+                   + modelSize->rules * fuzzyArenaAlign(sizeof(fuzzyRuleArray))
+                   + modelSize->sets * fuzzyArenaAlign(sizeof(fuzzySetArray))
+                   + consequentSets * fuzzyArenaAlign(sizeof(fuzzySetOutputArray));
+    req.scratchBytes = (size_t) modelSize->outputs * modelSize->maxPoints * fuzzyArenaAlign(sizeof(pointsArray));
+    req.arenaBytes = req.modelBytes + req.scratchBytes;
+    req.objectBytes = modelSize->inputs * sizeof(FuzzyInput)
+                    + modelSize->outputs * sizeof(FuzzyOutput)
+                    + modelSize->sets * sizeof(FuzzySet)
+                    + modelSize->rules * (sizeof(FuzzyRule) + sizeof(FuzzyRuleConsequent))
+                    + modelSize->antecedents * sizeof(FuzzyRuleAntecedent);
+    return req;
+}
+
+void Fuzzy::getWorstCase(fuzzyWorstCase* worstCase){
+    *worstCase = fuzzyWorstCase();
+
+    fuzzyInputArray* fuzzyInputAux = this->fuzzyInputs;
+    while(fuzzyInputAux != NULL){
+        uint32_t sets = fuzzyInputAux->fuzzyInput->countFuzzySets();
+        worstCase->membershipEvals += sets;
+        worstCase->setResets += sets;
+        fuzzyInputAux = fuzzyInputAux->next;
+    }
+
+    fuzzyRuleArray* fuzzyRuleAux = this->fuzzyRules;
+    while(fuzzyRuleAux != NULL){
+        worstCase->ruleNodeEvals += fuzzyRuleAux->fuzzyRule->countAntecedentNodes();
+        worstCase->consequentUpdates += fuzzyRuleAux->fuzzyRule->countConsequentOutputs();
+        fuzzyRuleAux = fuzzyRuleAux->next;
+    }
+
+    fuzzyOutputArray* fuzzyOutputAux = this->fuzzyOutputs;
+    while(fuzzyOutputAux != NULL){
+        uint32_t sets = fuzzyOutputAux->fuzzyOutput->countFuzzySets();
+        // truncate insere no máximo 4 pontos por conjunto, cada um precedido
+        // de um checkPoint sobre a composição inteira; o build insere um
+        // ponto por interseção mas remove ao menos dois, logo há no máximo
+        // points - 1 interseções e o build recomeça a cada uma delas, com até
+        // points^2 testes por passada
+        uint32_t points = 4 * sets;
+        uint32_t intersections = (points > 0) ? points - 1 : 0;
+        worstCase->setResets += sets;
+        if(points + 1 > worstCase->maxPoints){
+            worstCase->maxPoints = points + 1;
+        }
+        worstCase->pointChecks += 4 * sets * points;
+        worstCase->intersectionTests += (intersections + 1) * points * points;
+        worstCase->intersections += intersections;
+        worstCase->centroidSegments += points;
+        fuzzyOutputAux = fuzzyOutputAux->next;
+    }
+}
+
+uint32_t Fuzzy::worstCaseCycles(const fuzzyWorstCase* worstCase){
+    return worstCase->membershipEvals * (uint32_t) FUZZY_CYCLES_MEMBERSHIP
+         + worstCase->ruleNodeEvals * (uint32_t) FUZZY_CYCLES_RULE_NODE
+         + worstCase->consequentUpdates * (uint32_t) FUZZY_CYCLES_CONSEQUENT
+         + worstCase->setResets * (uint32_t) FUZZY_CYCLES_RESET
+         + worstCase->pointChecks * (uint32_t) FUZZY_CYCLES_POINT_CHECK
+         + worstCase->intersectionTests * (uint32_t) FUZZY_CYCLES_INTERSECTION_TEST
+         + worstCase->intersections * (uint32_t) FUZZY_CYCLES_INTERSECTION
+         + worstCase->centroidSegments * (uint32_t) FUZZY_CYCLES_CENTROID_SEGMENT;
+}
+
+#ifdef FUZZY_MEM_STATS
+fuzzyMemStats Fuzzy::getFuzzifyMemStats(){
+    return this->fuzzifyMemStats;
 }
 
+fuzzyMemStats Fuzzy::getDefuzzifyMemStats(){
+    return this->defuzzifyMemStats;
+}
+#endif
+
 // MÉTODOS PRIVADOS
+void Fuzzy::init(){
+    // Iniciando os ponteiros como nulo
+    // FuzzyInput
+    this->fuzzyInputs       = NULL;
+    this->fuzzyInputsCursor = NULL;
+    // FuzzyOutput
+    this->fuzzyOutputs          = NULL;
+    this->fuzzyOutputsCursor    = NULL;
+    // FuzzyRule
+    this->fuzzyRules        = NULL;
+    this->fuzzyRulesCursor  = NULL;
+#ifdef FUZZY_MEM_STATS
+    this->fuzzifyMemStats   = fuzzyMemStats();
+    this->defuzzifyMemStats = fuzzyMemStats();
+#endif
+    this->failed    = false;
+    this->ownsArena = false;
+}
+
 void Fuzzy::cleanFuzzyInputs(fuzzyInputArray* aux){
-    if(aux != NULL){
+    while(aux != NULL){
+        fuzzyInputArray* next = aux->next;
         // Esvaziando a memória alocada
-        this->cleanFuzzyInputs(aux->next);
-        free(aux);
+        fuzzyFree(this->getArena(), aux);
+        aux = next;
     }
 }
 
 void Fuzzy::cleanFuzzyOutputs(fuzzyOutputArray* aux){
-    if(aux != NULL){
+    while(aux != NULL){
+        fuzzyOutputArray* next = aux->next;
         // Esvaziando a memória alocada
-        this->cleanFuzzyOutputs(aux->next);
-        free(aux);
+        fuzzyFree(this->getArena(), aux);
+        aux = next;
     }
 }
 
 void Fuzzy::cleanFuzzyRules(fuzzyRuleArray* aux){
-    if(aux != NULL){
+    while(aux != NULL){
+        fuzzyRuleArray* next = aux->next;
         // Esvaziando a memória alocada
-        this->cleanFuzzyRules(aux->next);
-        free(aux);
+        fuzzyFree(this->getArena(), aux);
+        aux = next;
     }
 }
\ No newline at end of file
@@ -14,6 +14,7 @@
 
 // IMPORTANDO AS BIBLIOTECAS NECESSÁRIAS
 #include <inttypes.h>
+#include "FuzzyMemory.h"
 #include "FuzzyInput.h"
 #include "FuzzyOutput.h"
 #include "FuzzyRule.h"
@@ -36,10 +37,61 @@ struct fuzzyRuleArray{
     fuzzyRuleArray* next;
 };
 
+// Dimensões de um modelo, para calcular a memória antes de construí-lo
+struct fuzzyModelSize{
+    int inputs;
+    int outputs;
+    int sets;           // total de FuzzySets nas entradas e saídas
+    int rules;
+    int antecedents;    // total de FuzzyRuleAntecedent (nós das expressões)
+    int consequentSets; // total de addOutput nos consequentes; 0 = um por regra
+    int maxPoints;      // pontos por composição; 4 por conjunto de saída + 1 basta
+};
+
+// Memória necessária para um modelo
+struct fuzzyMemRequirements{
+    size_t modelBytes;   // nós das listas alocados pela biblioteca
+    size_t scratchBytes; // pontos das composições durante a avaliação
+    size_t arenaBytes;   // buffer para o construtor com arena (modelo + scratch)
+    size_t objectBytes;  // objetos FuzzyInput/Set/Rule/... criados pelo chamador
+};
+
+// Custo em ciclos de cada operação no AVR (float em software, 16 MHz).
+// Valores de referência; redefina com as medidas da sua placa.
+#ifndef FUZZY_CYCLES_MEMBERSHIP
+#define FUZZY_CYCLES_MEMBERSHIP 700
+#endif
+#ifndef FUZZY_CYCLES_RULE_NODE
+#define FUZZY_CYCLES_RULE_NODE 180
+#endif
+#ifndef FUZZY_CYCLES_CONSEQUENT
+#define FUZZY_CYCLES_CONSEQUENT 90
+#endif
+#ifndef FUZZY_CYCLES_RESET
+#define FUZZY_CYCLES_RESET 30
+#endif
+#ifndef FUZZY_CYCLES_POINT_CHECK
+#define FUZZY_CYCLES_POINT_CHECK 70
+#endif
+#ifndef FUZZY_CYCLES_INTERSECTION_TEST
+#define FUZZY_CYCLES_INTERSECTION_TEST 1600
+#endif
+#ifndef FUZZY_CYCLES_INTERSECTION
+#define FUZZY_CYCLES_INTERSECTION 700
+#endif
+#ifndef FUZZY_CYCLES_CENTROID_SEGMENT
+#define FUZZY_CYCLES_CENTROID_SEGMENT 1100
+#endif
+
 class Fuzzy {
     public:
         // CONSTRUTORES
         Fuzzy();
+        // Todas as alocações do motor saem de buffer (arenaBytes de sizeOf),
+        // sem nunca chamar malloc. Se o buffer for menor que o necessário
+        // nada é alocado e isValid() retorna falso. As entradas, saídas e
+        // consequentes deste Fuzzy devem ser criados com getArena().
+        Fuzzy(void* buffer, size_t bufferSize, const fuzzyModelSize* modelSize);
         // DESTRUTOR
         ~Fuzzy();
         // MÉTODOS PÚBLICOS
@@ -49,7 +101,19 @@ class Fuzzy {
         bool setInput(int fuzzyInputIndex, float crispValue);
         bool fuzzify();
         bool isFiredRule(int fuzzyRuleIndex);
+        int getFiredRules(int* fuzzyRuleIndexes, int maxCount);
         float defuzzify(int fuzzyOutputIndex);
+        bool isValid();
+        // Arena desta instância, NULL se ela usa o heap
+        fuzzyArena* getArena();
+        static fuzzyMemRequirements sizeOf(const fuzzyModelSize* modelSize);
+        void getWorstCase(fuzzyWorstCase* worstCase);
+        static uint32_t worstCaseCycles(const fuzzyWorstCase* worstCase);
+#ifdef FUZZY_MEM_STATS
+        // Estatísticas de memória da última chamada de fuzzify/defuzzify
+        fuzzyMemStats getFuzzifyMemStats();
+        fuzzyMemStats getDefuzzifyMemStats();
+#endif
 
     private:
         // VARIÁVEIS PRIVADAS
@@ -62,8 +126,18 @@ class Fuzzy {
         // ponteiros para gerenciar os arrays de FuzzyRule
         fuzzyRuleArray* fuzzyRulesCursor;
         fuzzyRuleArray* fuzzyRules;
+        // falha de alocação em alguma etapa da construção
+        bool failed;
+        // arena sobre o buffer do construtor, se houver
+        fuzzyArena arena;
+        bool ownsArena;
+#ifdef FUZZY_MEM_STATS
+        fuzzyMemStats fuzzifyMemStats;
+        fuzzyMemStats defuzzifyMemStats;
+#endif
 
         // MÉTODOS PRIVADOS
+        void init();
         void cleanFuzzyInputs(fuzzyInputArray* aux);
         void cleanFuzzyOutputs(fuzzyOutputArray* aux);
         void cleanFuzzyRules(fuzzyRuleArray* aux);
@@ -13,9 +13,10 @@
 #include <math.h>
 
 // CONSTRUTORES
-FuzzyComposition::FuzzyComposition(){
+FuzzyComposition::FuzzyComposition(fuzzyArena* arena){
     this->pointsCursor     = NULL;
     this->points         = NULL;
+    this->arena          = arena;
 }
 
 // DESTRUTOR
@@ -26,7 +27,7 @@ FuzzyComposition::~FuzzyComposition(){
 bool FuzzyComposition::addPoint(float point, float pertinence){
     pointsArray* aux;
     // Alocando espaço na memória
-    if((aux = (pointsArray* ) malloc(sizeof(pointsArray))) == NULL){
+    if((aux = (pointsArray* ) fuzzyScratchMalloc(this->arena, sizeof(pointsArray))) == NULL){
         return false;
     }
     aux->previous = NULL;
@@ -49,6 +50,7 @@ bool FuzzyComposition::checkPoint(float point, float pertinence){
     pointsArray* aux;
     aux = this->pointsCursor;
     while(aux != NULL){
+        FUZZY_COUNT_OP(pointChecks, 1);
         if(aux->point == point && aux->pertinence == pertinence){
             return true;
         }
@@ -60,6 +62,17 @@ bool FuzzyComposition::checkPoint(float point, float pertinence){
 bool FuzzyComposition::build(){
     pointsArray* aux;
 
+#ifdef FUZZY_OP_COUNT
+    // o build só remove pontos, a maior composição é a que ele recebe
+    uint32_t count = 0;
+    for(aux = this->points; aux != NULL; aux = aux->next){
+        count++;
+    }
+    if(count > fuzzyOpCounts.maxPoints){
+        fuzzyOpCounts.maxPoints = count;
+    }
+#endif
+
     aux = this->points;
     while(aux != NULL){
         pointsArray* temp = aux;
@@ -74,7 +87,8 @@ bool FuzzyComposition::build(){
             zPoint = temp;
             while(temp->previous != NULL){
                 bool result = false;
-                if(temp->previous->previous != NULL){
+                // o último ponto fora de ordem não tem segmento depois dele
+                if(temp->previous->previous != NULL && zPoint->next != NULL){
                     result = rebuild(zPoint, zPoint->next, temp->previous, temp->previous->previous);
                 }
                 if(result == true){
@@ -97,6 +111,7 @@ float FuzzyComposition::avaliate(){
     aux = this->points;
     while(aux != NULL){
         if(aux->next != NULL){
+            FUZZY_COUNT_OP(centroidSegments, 1);
             float area = 0.0;
             float middle = 0.0;
             if(aux->point == aux->next->point){
@@ -150,10 +165,12 @@ bool FuzzyComposition::empty(){
 
 // MÉTODOS PRIVADOS
 void FuzzyComposition::cleanPoints(pointsArray* aux){
-    if(aux != NULL){
+    // Iterativo para que a pilha não cresça com o tamanho da lista
+    while(aux != NULL){
+        pointsArray* next = aux->next;
         // Esvaziando a memória alocada
-        this->cleanPoints(aux->next);
-        free(aux);
+        fuzzyScratchFree(this->arena, aux);
+        aux = next;
     }
 }
 
@@ -170,6 +187,7 @@ bool FuzzyComposition::rebuild(pointsArray* aSegmentBegin, pointsArray* aSegment
     float denom, numera, numerb;
     float mua, mub;
 
+    FUZZY_COUNT_OP(intersectionTests, 1);
     denom  = (y4 - y3) * (x2 - x1) - (x4 - x3) * (y2 - y1);
     numera = (x4 - x3) * (y1 - y3) - (y4 - y3) * (x1 - x3);
     numerb = (x2 - x1) * (y1 - y3) - (y2 - y1) * (x1 - x3);
@@ -202,10 +220,11 @@ bool FuzzyComposition::rebuild(pointsArray* aSegmentBegin, pointsArray* aSegment
         // Adicionando um novo ponto
         pointsArray* aux;
         // Alocando espaço na memória
-        if((aux = (pointsArray *) malloc(sizeof(pointsArray))) == NULL){
+        if((aux = (pointsArray *) fuzzyScratchMalloc(this->arena, sizeof(pointsArray))) == NULL){
             return false;
         }
 
+        FUZZY_COUNT_OP(intersections, 1);
         aux->previous = bSegmentEnd;
         aux->point = point;
         aux->pertinence = pertinence;
@@ -214,15 +233,14 @@ bool FuzzyComposition::rebuild(pointsArray* aSegmentBegin, pointsArray* aSegment
         bSegmentEnd->next = aux;
         aSegmentEnd->previous = aux;
 
-        float stopPoint = bSegmentBegin->point;
-        float stopPertinence = bSegmentBegin->pertinence;
-
         pointsArray* temp = aSegmentBegin;
         pointsArray* excl;
 
+        // Removendo de aSegmentBegin até bSegmentBegin, já fora da lista;
+        // comparar o nó e não as coordenadas, um ponto repetido no meio
+        // pararia antes e os seguintes nunca seriam liberados
         do{
-            float pointToCompare = temp->point;
-            float pertinenceToCompare = temp->pertinence;
+            pointsArray* removed = temp;
 
             excl = temp->previous;
 
@@ -230,7 +248,7 @@ bool FuzzyComposition::rebuild(pointsArray* aSegmentBegin, pointsArray* aSegment
 
             temp = excl;
 
-            if(stopPoint == pointToCompare && stopPertinence == pertinenceToCompare){
+            if(removed == bSegmentBegin){
                 break;
             }
         }while(temp != NULL);
@@ -241,7 +259,7 @@ bool FuzzyComposition::rebuild(pointsArray* aSegmentBegin, pointsArray* aSegment
 
 bool FuzzyComposition::rmvPoint(pointsArray* point){
     if(point != NULL){
-        free(point);
+        fuzzyScratchFree(this->arena, point);
     }
     return true;
 }
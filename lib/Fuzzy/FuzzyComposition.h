@@ -14,6 +14,7 @@
 
 // IMPORTANDO AS BIBLIOTECAS NECESSÁRIAS
 #include <stdlib.h>
+#include "FuzzyMemory.h"
 
 // CONSTANTES
 #define EPS 1.0E-3
@@ -29,7 +30,7 @@ struct pointsArray{
 class FuzzyComposition{
     public:
         // CONSTRUTORES
-        FuzzyComposition();
+        FuzzyComposition(fuzzyArena* arena = NULL);
         // DESTRUTOR
         ~FuzzyComposition();
         // MÉTODOS PÚBLICOS
@@ -43,6 +44,7 @@ class FuzzyComposition{
         // VARIÁVEIS PRIVADAS
         pointsArray* pointsCursor;
         pointsArray* points;
+        fuzzyArena* arena;
 
         // MÉTODOS PRIVADOS
         void cleanPoints(pointsArray* aux);
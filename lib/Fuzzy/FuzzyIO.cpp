@@ -13,10 +13,12 @@
 
 // CONSTRUTORES
 FuzzyIO::FuzzyIO(){
+    this->arena = NULL;
 }
 
-FuzzyIO::FuzzyIO(int index){
+FuzzyIO::FuzzyIO(int index, fuzzyArena* arena){
     this->index = index;
+    this->arena = arena;
     // Iniciando os ponteiros como nulo
     this->fuzzySets          = NULL;
     this->fuzzySetsCursor    = NULL;
@@ -43,7 +45,7 @@ float FuzzyIO::getCrispInput(){
 bool FuzzyIO::addFuzzySet(FuzzySet* fuzzySet){
     fuzzySetArray *aux;
     // Alocando espaço na memória
-    if((aux = (fuzzySetArray *) malloc(sizeof(fuzzySetArray))) == NULL){
+    if((aux = (fuzzySetArray *) fuzzyMalloc(this->arena, sizeof(fuzzySetArray))) == NULL){
         return false;
     }
     aux->fuzzySet     = fuzzySet;
@@ -65,15 +67,32 @@ void FuzzyIO::resetFuzzySets(){
     // Calculando as pertinências de totos os FuzzyInputs
     while(fuzzySetsAux != NULL){
         fuzzySetsAux->fuzzySet->reset();
+        FUZZY_COUNT_OP(setResets, 1);
         fuzzySetsAux = fuzzySetsAux->next;
     }
 }
 
+int FuzzyIO::countFuzzySets(){
+    fuzzySetArray* fuzzySetsAux;
+    int count = 0;
+    fuzzySetsAux = this->fuzzySets;
+    while(fuzzySetsAux != NULL){
+        count++;
+        fuzzySetsAux = fuzzySetsAux->next;
+    }
+    return count;
+}
+
+fuzzyArena* FuzzyIO::getArena(){
+    return this->arena;
+}
+
 // MÉTODOS PROTEGIDOS
 void FuzzyIO::cleanFuzzySets(fuzzySetArray *aux){
-    if(aux != NULL){
+    while(aux != NULL){
+        fuzzySetArray* next = aux->next;
         // Esvaziando a memória alocada
-        this->cleanFuzzySets(aux->next);
-        free(aux);
+        fuzzyFree(this->arena, aux);
+        aux = next;
     }
 }
\ No newline at end of file
@@ -14,6 +14,7 @@
 
 // IMPORTANDO AS BIBLIOTECAS NECESSÁRIAS
 #include <stdlib.h>
+#include "FuzzyMemory.h"
 #include "FuzzySet.h"
 
 // Estrutura de uma lista de FuzzySet
@@ -26,7 +27,8 @@ class FuzzyIO {
     public:
         // CONSTRUTORES
         FuzzyIO();
-        FuzzyIO(int index);
+        // arena do Fuzzy dono deste objeto, NULL para usar o heap
+        FuzzyIO(int index, fuzzyArena* arena = NULL);
         // DESTRUTOR
         ~FuzzyIO();
         // MÉTODOS PÚBLICOS
@@ -35,11 +37,14 @@ class FuzzyIO {
         float getCrispInput();
         bool addFuzzySet(FuzzySet* fuzzySet);
         void resetFuzzySets();
+        int countFuzzySets();
+        fuzzyArena* getArena();
 
     protected:
         // VARIÁVEIS PROTEGIDAS
         int index;
         float crispInput;
+        fuzzyArena* arena;
         fuzzySetArray* fuzzySets;
         fuzzySetArray* fuzzySetsCursor;
         // MÉTODOS PROTEGIDOS
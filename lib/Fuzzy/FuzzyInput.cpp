@@ -15,7 +15,7 @@
 FuzzyInput::FuzzyInput() : FuzzyIO(){
 }
 
-FuzzyInput::FuzzyInput(int index) : FuzzyIO(index){
+FuzzyInput::FuzzyInput(int index, fuzzyArena* arena) : FuzzyIO(index, arena){
 }
 
 // DESTRUTOR
@@ -30,6 +30,7 @@ bool FuzzyInput::calculateFuzzySetPertinences(){
     while(aux != NULL){
         if (aux->fuzzySet != NULL){
             aux->fuzzySet->calculatePertinence(this->crispInput);
+            FUZZY_COUNT_OP(membershipEvals, 1);
         }
         aux = aux->next;
     }
@@ -19,7 +19,7 @@ class FuzzyInput : public FuzzyIO {
     public:
         // CONSTRUTORES
         FuzzyInput();
-        FuzzyInput(int index);
+        FuzzyInput(int index, fuzzyArena* arena = NULL);
         // DESTRUTOR
         ~FuzzyInput();
         // MÉTODOS PÚBLICOS
@@ -0,0 +1,228 @@
+/*
+ * Robotic Research Group (RRG)
+ * State University of Piaui (UESPI), Brazil - Piauí - Teresina
+ *
+ * FuzzyMemory.cpp
+ *
+ *      Author: Msc. Marvin Lemos <marvinlemos@gmail.com>
+ *              AJ Alves <aj.alves@zerokol.com>
+ *          Co authors: Douglas S. Kridi <douglaskridi@gmail.com>
+ *                      Kannya Leal <kannyal@hotmail.com>
+ */
+#include "FuzzyMemory.h"
+
+// CONSTANTES
+#define FUZZY_STACK_CANARY 0xC5
+// Margem abaixo do ponto de pintura que não é tocada (frame atual)
+#define FUZZY_STACK_MARGIN 16
+
+#ifdef FUZZY_OP_COUNT
+#if defined(__AVR__)
+fuzzyWorstCase fuzzyOpCounts;
+#else
+thread_local fuzzyWorstCase fuzzyOpCounts;
+#endif
+
+void fuzzyOpCountReset(){
+    fuzzyOpCounts = fuzzyWorstCase();
+}
+#endif
+
+#ifdef FUZZY_MEM_STATS
+// Cabeçalho guardado antes de cada bloco do heap para saber o tamanho no free
+union fuzzyMemHeader{
+    size_t size;
+    double align;
+};
+
+static fuzzyMemStats memStats;
+static uint32_t memInUse = 0;
+
+#if defined(__AVR__)
+extern uint8_t __heap_start;
+extern void* __brkval;
+static uint8_t* stackPaintTop = NULL;
+#endif
+
+static void countAlloc(size_t size){
+    memStats.allocs++;
+    memStats.bytesAllocated += size;
+    memInUse += size;
+    if(memInUse > memStats.peakHeap){
+        memStats.peakHeap = memInUse;
+    }
+}
+
+static void countFree(size_t size){
+    memStats.frees++;
+    memInUse -= size;
+}
+
+static void* heapMalloc(size_t size){
+    fuzzyMemHeader* aux;
+    if((aux = (fuzzyMemHeader*) malloc(sizeof(fuzzyMemHeader) + size)) == NULL){
+        return NULL;
+    }
+    aux->size = size;
+    countAlloc(size);
+    return (void*) (aux + 1);
+}
+
+static void heapFree(void* ptr){
+    fuzzyMemHeader* aux = ((fuzzyMemHeader*) ptr) - 1;
+    countFree(aux->size);
+    free(aux);
+}
+#else
+#define countAlloc(size)
+#define countFree(size)
+#define heapMalloc(size) malloc(size)
+#define heapFree(ptr) free(ptr)
+#endif
+
+// MÉTODOS PÚBLICOS
+void* fuzzyMalloc(fuzzyArena* arena, size_t size){
+    if(arena == NULL){
+        return heapMalloc(size);
+    }
+    size = fuzzyArenaAlign(size);
+    if(arena->failed || arena->used + size > arena->modelBytes){
+        arena->failed = true;
+        return NULL;
+    }
+    void* aux = arena->base + arena->used;
+    arena->used += size;
+    countAlloc(size);
+    return aux;
+}
+
+void fuzzyFree(fuzzyArena* arena, void* ptr){
+    // O modelo na arena só é liberado junto com o buffer; a arena não é
+    // acessada, então o objeto pode ser destruído depois do seu Fuzzy
+    if(ptr != NULL && arena == NULL){
+        heapFree(ptr);
+    }
+}
+
+void* fuzzyScratchMalloc(fuzzyArena* arena, size_t size){
+    if(arena == NULL){
+        return heapMalloc(size);
+    }
+    if(size > arena->scratchBlockSize || arena->freeBlocks == NULL){
+        arena->scratchFailed = true;
+        return NULL;
+    }
+    fuzzyScratchBlock* aux = arena->freeBlocks;
+    arena->freeBlocks = aux->next;
+    countAlloc(arena->scratchBlockSize);
+    return (void*) aux;
+}
+
+void fuzzyScratchFree(fuzzyArena* arena, void* ptr){
+    if(ptr == NULL){
+        return;
+    }
+    if(arena == NULL){
+        heapFree(ptr);
+        return;
+    }
+    fuzzyScratchBlock* aux = (fuzzyScratchBlock*) ptr;
+    aux->next = arena->freeBlocks;
+    arena->freeBlocks = aux;
+    countFree(arena->scratchBlockSize);
+}
+
+size_t fuzzyArenaAlign(size_t size){
+    return (size + FUZZY_ARENA_ALIGN - 1) & ~((size_t) FUZZY_ARENA_ALIGN - 1);
+}
+
+bool fuzzyArenaInit(fuzzyArena* arena, void* buffer, size_t modelBytes, size_t scratchBytes, size_t scratchBlockSize){
+    if(arena == NULL || buffer == NULL){
+        return false;
+    }
+    if(scratchBlockSize < sizeof(fuzzyScratchBlock)){
+        scratchBlockSize = sizeof(fuzzyScratchBlock);
+    }
+    scratchBlockSize = fuzzyArenaAlign(scratchBlockSize);
+
+    arena->base = (uint8_t*) buffer;
+    arena->modelBytes = fuzzyArenaAlign(modelBytes);
+    arena->used = 0;
+    arena->scratchBegin = arena->base + arena->modelBytes;
+    arena->scratchEnd = arena->scratchBegin + (scratchBytes / scratchBlockSize) * scratchBlockSize;
+    arena->scratchBlockSize = scratchBlockSize;
+    arena->freeBlocks = NULL;
+    arena->failed = false;
+    arena->scratchFailed = false;
+
+    // Encadeando os blocos livres do fim para o começo
+    uint8_t* aux = arena->scratchEnd;
+    while(aux > arena->scratchBegin){
+        aux -= scratchBlockSize;
+        fuzzyScratchBlock* block = (fuzzyScratchBlock*) aux;
+        block->next = arena->freeBlocks;
+        arena->freeBlocks = block;
+    }
+    return true;
+}
+
+bool fuzzyArenaFailed(fuzzyArena* arena){
+    return arena != NULL && arena->failed;
+}
+
+bool fuzzyScratchFailed(fuzzyArena* arena){
+    return arena != NULL && arena->scratchFailed;
+}
+
+void fuzzyScratchReset(fuzzyArena* arena){
+    if(arena != NULL){
+        arena->scratchFailed = false;
+    }
+}
+
+#ifdef FUZZY_MEM_STATS
+void fuzzyMemStatsReset(){
+    memStats.allocs = 0;
+    memStats.frees = 0;
+    memStats.bytesAllocated = 0;
+    memStats.peakHeap = memInUse;
+    memStats.peakStack = 0;
+}
+
+void fuzzyMemStatsGet(fuzzyMemStats* stats){
+    *stats = memStats;
+    stats->peakStack = fuzzyStackPeak();
+}
+
+uint32_t fuzzyMemInUse(){
+    return memInUse;
+}
+
+void fuzzyStackPaint(){
+#if defined(__AVR__)
+    uint8_t marker;
+    uint8_t* aux = (__brkval == NULL) ? &__heap_start : (uint8_t*) __brkval;
+
+    stackPaintTop = &marker - FUZZY_STACK_MARGIN;
+    while(aux < stackPaintTop){
+        *aux++ = FUZZY_STACK_CANARY;
+    }
+#endif
+}
+
+uint32_t fuzzyStackPeak(){
+#if defined(__AVR__)
+    if(stackPaintTop == NULL){
+        return 0;
+    }
+    // O heap pode ter crescido sobre a pintura; começa do topo atual dele
+    uint8_t* aux = (__brkval == NULL) ? &__heap_start : (uint8_t*) __brkval;
+    while(aux < stackPaintTop && *aux == FUZZY_STACK_CANARY){
+        aux++;
+    }
+    return (uint32_t) (stackPaintTop - aux) + FUZZY_STACK_MARGIN;
+#else
+    return 0;
+#endif
+}
+#endif
@@ -0,0 +1,131 @@
+/*
+ * Robotic Research Group (RRG)
+ * State University of Piaui (UESPI), Brazil - Piauí - Teresina
+ *
+ * FuzzyMemory.h
+ *
+ *      Author: Msc. Marvin Lemos <marvinlemos@gmail.com>
+ *              AJ Alves <aj.alves@zerokol.com>
+ *          Co authors: Douglas S. Kridi <douglaskridi@gmail.com>
+ *                      Kannya Leal <kannyal@hotmail.com>
+ */
+#ifndef FUZZYMEMORY_H
+#define FUZZYMEMORY_H
+
+// IMPORTANDO AS BIBLIOTECAS NECESSÁRIAS
+#include <stdlib.h>
+#include <inttypes.h>
+
+// Toda alocação da biblioteca passa por fuzzyMalloc/fuzzyFree (nós das
+// listas do modelo) e fuzzyScratchMalloc/fuzzyScratchFree (pontos das
+// composições, refeitos a cada avaliação).
+//
+// Cada chamada recebe a arena do objeto que aloca. Com arena NULL as quatro
+// usam malloc/free. Com uma arena (fuzzyArenaInit) o modelo é alocado
+// sequencialmente no início do buffer do chamador e os pontos saem de um
+// pool de blocos de tamanho fixo no final dele; malloc nunca é chamado. Uma
+// alocação de modelo que não cabe marca a arena como falha e todas as
+// seguintes falham também, de modo que a construção nunca fica pela metade
+// sem aviso. A arena pertence a um Fuzzy e é passada aos objetos dele na
+// construção (FuzzyInput, FuzzyOutput, FuzzyRuleConsequent), então várias
+// arenas e objetos no heap convivem no mesmo programa.
+//
+// Compilando com -DFUZZY_MEM_STATS cada chamada é contabilizada (quantidade,
+// bytes, pico de heap) e, no AVR, a pilha pode ser pintada para medir a
+// profundidade máxima.
+
+// CONSTANTES
+#if defined(__AVR__)
+#define FUZZY_ARENA_ALIGN 1
+#else
+#define FUZZY_ARENA_ALIGN 8
+#endif
+
+// Estrutura com as estatísticas de memória de uma chamada
+struct fuzzyMemStats{
+    uint16_t allocs;
+    uint16_t frees;
+    uint32_t bytesAllocated;
+    uint32_t peakHeap;
+    uint32_t peakStack;
+};
+
+// Contagem de operações no pior caso de fuzzify() + defuzzify() de todas as
+// saídas, para um modelo que não muda mais (Fuzzy::getWorstCase). Com
+// FUZZY_OP_COUNT as mesmas operações são contadas durante a avaliação.
+struct fuzzyWorstCase{
+    uint32_t membershipEvals;   // calculatePertinence nas entradas
+    uint32_t ruleNodeEvals;     // nós de antecedentes avaliados
+    uint32_t consequentUpdates; // setPertinence nos consequentes
+    uint32_t setResets;         // reset dos conjuntos de entrada e saída
+    uint32_t maxPoints;         // maior composição de uma saída
+    uint32_t pointChecks;       // comparações de checkPoint no truncate
+    uint32_t intersectionTests; // chamadas de rebuild no build
+    uint32_t intersections;     // interseções efetivamente inseridas
+    uint32_t centroidSegments;  // segmentos somados no avaliate
+};
+
+// Estrutura de um bloco livre do pool de scratch
+struct fuzzyScratchBlock{
+    fuzzyScratchBlock* next;
+};
+
+// Estado de uma arena sobre o buffer do chamador
+struct fuzzyArena{
+    uint8_t* base;
+    size_t modelBytes;
+    size_t used;
+    uint8_t* scratchBegin;
+    uint8_t* scratchEnd;
+    size_t scratchBlockSize;
+    fuzzyScratchBlock* freeBlocks;
+    bool failed;
+    bool scratchFailed;
+};
+
+void* fuzzyMalloc(fuzzyArena* arena, size_t size);
+void fuzzyFree(fuzzyArena* arena, void* ptr);
+void* fuzzyScratchMalloc(fuzzyArena* arena, size_t size);
+void fuzzyScratchFree(fuzzyArena* arena, void* ptr);
+
+// Tamanho arredondado para o alinhamento usado na arena
+size_t fuzzyArenaAlign(size_t size);
+// Prepara a arena: modelBytes para o modelo seguidos de scratchBytes
+// divididos em blocos de scratchBlockSize. Retorna falso sem buffer.
+bool fuzzyArenaInit(fuzzyArena* arena, void* buffer, size_t modelBytes, size_t scratchBytes, size_t scratchBlockSize);
+// Verdadeiro se alguma alocação de modelo não coube na arena
+bool fuzzyArenaFailed(fuzzyArena* arena);
+// Verdadeiro se faltou bloco de scratch desde o último fuzzyScratchReset
+bool fuzzyScratchFailed(fuzzyArena* arena);
+void fuzzyScratchReset(fuzzyArena* arena);
+
+#ifdef FUZZY_MEM_STATS
+// Zera os contadores e o pico de heap (o pico passa a ser medido a partir
+// do uso atual)
+void fuzzyMemStatsReset();
+// Copia os contadores acumulados desde o último fuzzyMemStatsReset
+void fuzzyMemStatsGet(fuzzyMemStats* stats);
+// Bytes atualmente alocados pela biblioteca
+uint32_t fuzzyMemInUse();
+// Pinta a pilha livre (AVR) para que fuzzyStackPeak meça o uso máximo
+void fuzzyStackPaint();
+// Bytes de pilha usados abaixo do ponto de pintura; 0 fora do AVR
+uint32_t fuzzyStackPeak();
+#endif
+
+#ifdef FUZZY_OP_COUNT
+// Compilando com -DFUZZY_OP_COUNT cada operação de fuzzyWorstCase é contada
+// onde acontece, para conferir o limite de Fuzzy::getWorstCase. maxPoints é
+// a maior composição vista. No host o contador é por thread.
+#if defined(__AVR__)
+extern fuzzyWorstCase fuzzyOpCounts;
+#else
+extern thread_local fuzzyWorstCase fuzzyOpCounts;
+#endif
+void fuzzyOpCountReset();
+#define FUZZY_COUNT_OP(field, n) (fuzzyOpCounts.field += (n))
+#else
+#define FUZZY_COUNT_OP(field, n)
+#endif
+
+#endif
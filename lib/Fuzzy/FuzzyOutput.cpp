@@ -13,9 +13,11 @@
 
 // CONSTRUTORES
 FuzzyOutput::FuzzyOutput() : FuzzyIO(){
+    this->invalidate();
 }
 
-FuzzyOutput::FuzzyOutput(int index) : FuzzyIO(index){
+FuzzyOutput::FuzzyOutput(int index, fuzzyArena* arena) : FuzzyIO(index, arena), fuzzyComposition(arena){
+    this->invalidate();
 }
 
 // DESTRUTOR
@@ -112,11 +114,32 @@ bool FuzzyOutput::truncate(){
 
     this->fuzzyComposition.build();
 
+    this->truncated = true;
+    this->crispValid = false;
     return true;
 }
 
 float FuzzyOutput::getCrispOutput(){
-    return this->fuzzyComposition.avaliate();
+    if(!this->truncated){
+        this->truncate();
+    }
+    if(!this->crispValid){
+        this->crispOutput = this->fuzzyComposition.avaliate();
+        this->crispValid = true;
+    }
+    return this->crispOutput;
+}
+
+void FuzzyOutput::invalidate(){
+    this->truncated = false;
+    this->crispValid = false;
+    this->crispOutput = 0.0;
+}
+
+// Devolve os pontos da composição, antes que a arena deixe de existir
+void FuzzyOutput::release(){
+    this->fuzzyComposition.empty();
+    this->invalidate();
 }
 
 // Um simples Bubble Sort
@@ -28,17 +28,24 @@ class FuzzyOutput : public FuzzyIO {
     public:
         // CONSTRUTORES
         FuzzyOutput();
-        FuzzyOutput(int index);
+        FuzzyOutput(int index, fuzzyArena* arena = NULL);
         // DESTRUTOR
         ~FuzzyOutput();
         // MÉTODOS PÚBLICOS
         bool truncate();
         float getCrispOutput();
+        void invalidate();
+        void release();
         bool order();
 
     private:
         // VARIÁVEIS PRIVADAS
         FuzzyComposition fuzzyComposition;
+        // truncate e avaliate só são refeitos quando a saída é lida depois
+        // de um novo fuzzify
+        bool truncated;
+        bool crispValid;
+        float crispOutput;
         // MÉTODOS PRIVADOS
         bool swap(fuzzySetArray* fuzzySetA, fuzzySetArray* fuzzySetB);
         bool rebuild(float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4, float* point, float* pertinence);
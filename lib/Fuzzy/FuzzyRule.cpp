@@ -38,4 +38,25 @@ bool FuzzyRule::evaluateExpression(){
 
 bool FuzzyRule::isFired(){
     return this->fired;
+}
+
+int FuzzyRule::countAntecedentNodes(){
+    if(this->fuzzyRuleAntecedent == NULL){
+        return 0;
+    }
+    return this->fuzzyRuleAntecedent->countNodes();
+}
+
+int FuzzyRule::countConsequentOutputs(){
+    if(this->fuzzyRuleConsequent == NULL){
+        return 0;
+    }
+    return this->fuzzyRuleConsequent->countOutputs();
+}
+
+fuzzyArena* FuzzyRule::getArena(){
+    if(this->fuzzyRuleConsequent == NULL){
+        return NULL;
+    }
+    return this->fuzzyRuleConsequent->getArena();
 }
\ No newline at end of file
@@ -25,6 +25,9 @@ class FuzzyRule {
         int getIndex();
         bool evaluateExpression();
         bool isFired();
+        int countAntecedentNodes();
+        int countConsequentOutputs();
+        fuzzyArena* getArena();
 
     private:
         // VARIÁVEIS PRIVADAS
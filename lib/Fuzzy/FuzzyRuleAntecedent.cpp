@@ -120,96 +120,51 @@ bool FuzzyRuleAntecedent::joinWithOR(FuzzyRuleAntecedent* fuzzyRuleAntecedent1,
 }
 
 float FuzzyRuleAntecedent::evaluate(){
+    // Cada operando é avaliado uma única vez, de modo que o custo é linear no
+    // número de nós da expressão (ver countNodes)
+    float value1, value2;
+    FUZZY_COUNT_OP(ruleNodeEvals, 1);
     switch(this->mode){
         case MODE_FS:
             return this->fuzzySet1->getPertinence();
-            break;
         case MODE_FS_FS:
-            switch(this->op){
-                case OP_AND:
-                    if(this->fuzzySet1->getPertinence() > 0.0 && this->fuzzySet2->getPertinence() > 0.0){
-                        if(this->fuzzySet1->getPertinence() < this->fuzzySet2->getPertinence()){
-                            return this->fuzzySet1->getPertinence();
-                        }else{
-                            return this->fuzzySet2->getPertinence();
-                        }
-                    }else{
-                        return 0.0;
-                    }
-                    break;
-                case OP_OR:
-                    if(this->fuzzySet1->getPertinence() > 0.0 || this->fuzzySet2->getPertinence() > 0.0){
-                        if(this->fuzzySet1->getPertinence() > this->fuzzySet2->getPertinence()){
-                            return this->fuzzySet1->getPertinence();
-                        }else{
-                            return this->fuzzySet2->getPertinence();
-                        }
-                    }else{
-                        return 0.0;
-                    }
-                    break;
-                default:
-                    return 0.0;
-            }
+            value1 = this->fuzzySet1->getPertinence();
+            value2 = this->fuzzySet2->getPertinence();
             break;
         case MODE_FS_FRA:
-            switch(this->op){
-                case OP_AND:
-                    if(this->fuzzySet1->getPertinence() > 0.0 && fuzzyRuleAntecedent1->evaluate() > 0.0){
-                        if(this->fuzzySet1->getPertinence() < fuzzyRuleAntecedent1->evaluate()){
-                            return this->fuzzySet1->getPertinence();
-                        }else{
-                            return fuzzyRuleAntecedent1->evaluate();
-                        }
-                    }else{
-                        return 0.0;
-                    }
-                    break;
-                case OP_OR:
-                    if(this->fuzzySet1->getPertinence() > 0.0 || fuzzyRuleAntecedent1->evaluate() > 0.0){
-                        if(this->fuzzySet1->getPertinence() > fuzzyRuleAntecedent1->evaluate()){
-                            return this->fuzzySet1->getPertinence();
-                        }else{
-                            return fuzzyRuleAntecedent1->evaluate();
-                        }
-                    }else{
-                        return 0.0;
-                    }
-                    break;
-                default:
-                    return 0.0;
-            }
+            value1 = this->fuzzySet1->getPertinence();
+            value2 = this->fuzzyRuleAntecedent1->evaluate();
             break;
         case MODE_FRA_FRA:
-            switch(this->op){
-                case OP_AND:
-                    if(fuzzyRuleAntecedent1->evaluate() > 0.0 && fuzzyRuleAntecedent2->evaluate() > 0.0){
-                        if(fuzzyRuleAntecedent1->evaluate() < fuzzyRuleAntecedent2->evaluate()){
-                            return fuzzyRuleAntecedent1->evaluate();
-                        }else{
-                            return fuzzyRuleAntecedent2->evaluate();
-                        }
-                    }else{
-                        return 0.0;
-                    }
-                    break;
-                case OP_OR:
-                    if(fuzzyRuleAntecedent1->evaluate() > 0.0 || fuzzyRuleAntecedent2->evaluate() > 0.0){
-                        if(fuzzyRuleAntecedent1->evaluate() > fuzzyRuleAntecedent2->evaluate()){
-                            return fuzzyRuleAntecedent1->evaluate();
-                        }else{
-                            return fuzzyRuleAntecedent2->evaluate();
-                        }
-                    }else{
-                        return 0.0;
-                    }
-                    break;
-                default:
-                    return 0.0;
-            }
+            value1 = this->fuzzyRuleAntecedent1->evaluate();
+            value2 = this->fuzzyRuleAntecedent2->evaluate();
             break;
         default:
             return 0.0;
     }
-    return 0.0;
+    switch(this->op){
+        case OP_AND:
+            if(value1 > 0.0 && value2 > 0.0){
+                return (value1 < value2) ? value1 : value2;
+            }
+            return 0.0;
+        case OP_OR:
+            if(value1 > 0.0 || value2 > 0.0){
+                return (value1 > value2) ? value1 : value2;
+            }
+            return 0.0;
+        default:
+            return 0.0;
+    }
+}
+
+int FuzzyRuleAntecedent::countNodes(){
+    switch(this->mode){
+        case MODE_FS_FRA:
+            return 1 + this->fuzzyRuleAntecedent1->countNodes();
+        case MODE_FRA_FRA:
+            return 1 + this->fuzzyRuleAntecedent1->countNodes() + this->fuzzyRuleAntecedent2->countNodes();
+        default:
+            return 1;
+    }
 }
\ No newline at end of file
@@ -14,6 +14,7 @@
 
 // IMPORTANDO AS BIBLIOTECAS NECESSÁRIAS
 #include <stdlib.h>
+#include "FuzzyMemory.h"
 #include "FuzzySet.h"
 
 // CONSTANTES
@@ -39,6 +40,7 @@ class FuzzyRuleAntecedent {
         bool joinWithAND(FuzzyRuleAntecedent* fuzzyRuleAntecedent1, FuzzyRuleAntecedent* fuzzyRuleAntecedent2);
         bool joinWithOR(FuzzyRuleAntecedent* fuzzyRuleAntecedent1, FuzzyRuleAntecedent* fuzzyRuleAntecedent2);
         float evaluate();
+        int countNodes();
 
     private:
         // VARIÁVEIS PRIVADAS
@@ -12,9 +12,10 @@
 #include "FuzzyRuleConsequent.h"
 
 // CONSTRUTORES
-FuzzyRuleConsequent::FuzzyRuleConsequent(){
+FuzzyRuleConsequent::FuzzyRuleConsequent(fuzzyArena* arena){
     this->fuzzySetOutputs = NULL;
     this->fuzzySetOutputsCursor = NULL;
+    this->arena = arena;
 }
 
 // DESTRUTOR
@@ -26,7 +27,7 @@ FuzzyRuleConsequent::~FuzzyRuleConsequent(){
 bool FuzzyRuleConsequent::addOutput(FuzzySet* fuzzySet){
     fuzzySetOutputArray *aux;
     // Alocando espaço na memória
-    if((aux = (fuzzySetOutputArray *) malloc(sizeof(fuzzySetOutputArray))) == NULL){
+    if((aux = (fuzzySetOutputArray *) fuzzyMalloc(this->arena, sizeof(fuzzySetOutputArray))) == NULL){
         return false;
     }
     aux->fuzzySet     = fuzzySet;
@@ -47,16 +48,33 @@ bool FuzzyRuleConsequent::evaluate(float power){
     aux = this->fuzzySetOutputs;
     while(aux != NULL){
         aux->fuzzySet->setPertinence(power);
+        FUZZY_COUNT_OP(consequentUpdates, 1);
         aux = aux->next;
     }
     return true;
 }
 
+int FuzzyRuleConsequent::countOutputs(){
+    fuzzySetOutputArray *aux;
+    int count = 0;
+    aux = this->fuzzySetOutputs;
+    while(aux != NULL){
+        count++;
+        aux = aux->next;
+    }
+    return count;
+}
+
+fuzzyArena* FuzzyRuleConsequent::getArena(){
+    return this->arena;
+}
+
 // MÉTODOS PRIVADOS
 void FuzzyRuleConsequent::cleanFuzzySets(fuzzySetOutputArray* aux){
-    if(aux != NULL){
+    while(aux != NULL){
+        fuzzySetOutputArray* next = aux->next;
         // Esvaziando a memória alocada
-        this->cleanFuzzySets(aux->next);
-        free(aux);
+        fuzzyFree(this->arena, aux);
+        aux = next;
     }
 }
\ No newline at end of file
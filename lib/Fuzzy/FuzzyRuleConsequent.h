@@ -14,6 +14,7 @@
 
 // IMPORTANDO AS BIBLIOTECAS NECESSÁRIAS
 #include <stdlib.h>
+#include "FuzzyMemory.h"
 #include "FuzzySet.h"
 
 // Estrutura de uma lista de FuzzySet
@@ -25,17 +26,21 @@ struct fuzzySetOutputArray{
 class FuzzyRuleConsequent {
     public:
         // CONSTRUTORES
-        FuzzyRuleConsequent();
+        // arena do Fuzzy dono da regra, NULL para usar o heap
+        FuzzyRuleConsequent(fuzzyArena* arena = NULL);
         // DESTRUTOR
         ~FuzzyRuleConsequent();
         // MÉTODOS PÚBLICOS
         bool addOutput(FuzzySet* fuzzySet);
         bool evaluate(float power);
+        int countOutputs();
+        fuzzyArena* getArena();
 
     private:
         // VARIÁVEIS PRIVADAS
         fuzzySetOutputArray* fuzzySetOutputsCursor;
         fuzzySetOutputArray* fuzzySetOutputs;
+        fuzzyArena* arena;
         // MÉTODOS PRIVADOS
         void cleanFuzzySets(fuzzySetOutputArray* aux);
 };
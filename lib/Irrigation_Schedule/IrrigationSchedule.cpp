@@ -0,0 +1,318 @@
+#include "IrrigationSchedule.h"
+#include <EEPROM.h>
+#include <stddef.h>
+
+#define SECONDS_PER_DAY 86400UL
+#define MINUTES_PER_DAY 1440
+
+// how far back a power loss is replayed to count the missed slots
+#define IRR_MISSED_SCAN (7 * SECONDS_PER_DAY)
+
+// last fired time in eeprom
+typedef struct {
+  uint32_t last_fired;
+  uint8_t checksum;
+} irr_state_t;
+
+#define IRR_STATE_ADDR (IRR_EEPROM_ADDR + sizeof(irr_config_t))
+
+// detail implementation
+// init class
+IrrigationSchedule::IrrigationSchedule() {
+  defaultConfig(&config);
+  last_fired = 0;
+  next_fire = IRR_NEVER;
+  next_window = catchup_window = IRR_NO_WINDOW;
+  skipped_count = 0;
+}
+
+/**
+ * the built in schedule: every day, 7 to 15, every 2 hours, one zone with
+ * the fuzzy duration as is
+ * @method defaultConfig
+ * @param  config        config output
+ */
+void IrrigationSchedule::defaultConfig(irr_config_t *config) {
+  memset(config, 0, sizeof(*config));
+  config->magic = IRR_MAGIC;
+  config->version = IRR_VERSION;
+  config->window_count = 1;
+  config->zone_count = 1;
+  config->catchup_min = 30;
+  config->zones[0].scale_pct = 100;
+  config->zones[0].max_min = 0;
+  config->windows[0].start_min = 7 * 60;
+  config->windows[0].end_min = 15 * 60;
+  config->windows[0].every_min = 120;
+  config->windows[0].dow_mask = IRR_EVERY_DAY;
+  config->windows[0].zone = 0;
+  config->checksum = checksum((const uint8_t *)config,
+                              offsetof(irr_config_t, checksum));
+}
+
+/**
+ * load the schedule from eeprom, write the default one if there is none,
+ * then work out the slots missed since the last one fired
+ * @method begin
+ * @param  now   local time, seconds since 1970
+ */
+void IrrigationSchedule::begin(uint32_t now) {
+  EEPROM.get(IRR_EEPROM_ADDR, config);
+  if (!valid(&config)) {
+    defaultConfig(&config);
+    EEPROM.put(IRR_EEPROM_ADDR, config);
+  }
+  load(now);
+}
+
+/**
+ * replace the schedule and save it to eeprom
+ * @method setConfig
+ * @param  config    new schedule, magic, version and checksum are filled in
+ * @param  now       local time, seconds since 1970
+ * @return           false if the schedule is out of range, nothing changed
+ */
+bool IrrigationSchedule::setConfig(const irr_config_t *config, uint32_t now) {
+  irr_config_t cfg = *config;
+  cfg.magic = IRR_MAGIC;
+  cfg.version = IRR_VERSION;
+  cfg.checksum =
+      checksum((const uint8_t *)&cfg, offsetof(irr_config_t, checksum));
+  if (!valid(&cfg)) {
+    return false;
+  }
+
+  this->config = cfg;
+  EEPROM.put(IRR_EEPROM_ADDR, this->config);
+  next_fire = nextAfter(now, &next_window);
+  return true;
+}
+
+/**
+ * current schedule
+ * @method getConfig
+ */
+void IrrigationSchedule::getConfig(irr_config_t *config) {
+  *config = this->config;
+}
+
+/**
+ * next fire time, IRR_NEVER if the schedule is empty
+ * @method next
+ */
+uint32_t IrrigationSchedule::next(void) { return next_fire; }
+
+/**
+ * is the next slot reached
+ * @method due
+ * @param  now local time, seconds since 1970
+ */
+bool IrrigationSchedule::due(uint32_t now) {
+  return (next_fire != IRR_NEVER) && (now >= next_fire);
+}
+
+/**
+ * take the due slot and move to the next one. slots passed meanwhile (clock
+ * set forward) are counted as skipped.
+ * @method fire
+ * @param  now  local time, seconds since 1970
+ * @return      window of the slot, IRR_NO_WINDOW if none was due
+ */
+int8_t IrrigationSchedule::fire(uint32_t now) {
+  if (!due(now)) {
+    return IRR_NO_WINDOW;
+  }
+
+  int8_t window = next_window;
+  last_fired = next_fire;
+  saveLastFired();
+
+  int8_t w;
+  for (uint32_t t = nextAfter(last_fired, &w); t <= now;
+       t = nextAfter(t, &w)) {
+    skipped_count++;
+  }
+  next_fire = nextAfter(now, &next_window);
+  return window;
+}
+
+/**
+ * slot missed during a power loss that should still run, only reported once
+ * @method catchup
+ * @return         window of the slot, IRR_NO_WINDOW if none
+ */
+int8_t IrrigationSchedule::catchup(void) {
+  int8_t window = catchup_window;
+  catchup_window = IRR_NO_WINDOW;
+  return window;
+}
+
+/**
+ * number of slots dropped, missed during a power loss or a clock change
+ * @method skipped
+ */
+uint16_t IrrigationSchedule::skipped(void) { return skipped_count; }
+
+/**
+ * apply the zone parameters of a window to the fuzzy duration
+ * @method duration
+ * @param  window       window of the slot
+ * @param  duration_min fuzzy duration, minutes
+ * @return              duration to run, minutes
+ */
+float IrrigationSchedule::duration(int8_t window, float duration_min) {
+  if ((window < 0) || (window >= config.window_count)) {
+    return 0.0;
+  }
+
+  irr_zone_t *zone = &config.zones[config.windows[window].zone];
+  duration_min = duration_min * zone->scale_pct / 100.0;
+  if (zone->max_min && (duration_min > zone->max_min)) {
+    duration_min = zone->max_min;
+  }
+  return duration_min;
+}
+
+/**
+ * first slot strictly after a time. each window gives at most one candidate
+ * per day, found by arithmetic, so the cost is windows x 8 days at worst.
+ * @method nextAfter
+ * @param  after     local time, seconds since 1970
+ * @param  window    window of the slot
+ * @return           slot time, IRR_NEVER if the schedule is empty
+ */
+uint32_t IrrigationSchedule::nextAfter(uint32_t after, int8_t *window) {
+  uint32_t best = IRR_NEVER;
+  *window = IRR_NO_WINDOW;
+
+  uint32_t day = after / SECONDS_PER_DAY;
+  // first whole minute after the time
+  uint16_t from_min = (after % SECONDS_PER_DAY) / 60 + 1;
+
+  // a week and one day, a window later today may only come back next week
+  for (uint8_t d = 0; (d <= 7) && (best == IRR_NEVER); d++, day++) {
+    // 1970-01-01 was a thursday
+    uint8_t dow_bit = 1 << ((day + 3) % 7);
+
+    for (uint8_t i = 0; i < config.window_count; i++) {
+      irr_window_t *w = &config.windows[i];
+      if (!(w->dow_mask & dow_bit)) {
+        continue;
+      }
+
+      uint16_t start = w->start_min;
+      if ((d == 0) && (from_min > start)) {
+        if (w->every_min == 0) {
+          continue;
+        }
+        start += ((from_min - start + w->every_min - 1) / w->every_min) *
+                 w->every_min;
+        if ((start > w->end_min) || (start >= MINUTES_PER_DAY)) {
+          continue;
+        }
+      }
+
+      uint32_t t = day * SECONDS_PER_DAY + start * 60UL;
+      if (t < best) {
+        best = t;
+        *window = i;
+      }
+    }
+  }
+  return best;
+}
+
+/**
+ * read the last fired time and settle the slots missed since then. the most
+ * recent one runs late if it is within catchup_min, the rest are skipped.
+ * @method load
+ * @param  now  local time, seconds since 1970
+ */
+void IrrigationSchedule::load(uint32_t now) {
+  irr_state_t state;
+  EEPROM.get(IRR_STATE_ADDR, state);
+  last_fired = state.last_fired;
+
+  // nothing stored or the clock went back, nothing was missed
+  if ((checksum((const uint8_t *)&state, offsetof(irr_state_t, checksum)) !=
+       state.checksum) ||
+      (last_fired == 0) || (last_fired > now)) {
+    last_fired = now;
+  }
+  if (now - last_fired > IRR_MISSED_SCAN) {
+    last_fired = now - IRR_MISSED_SCAN;
+  }
+
+  int8_t w, missed_window = IRR_NO_WINDOW;
+  uint32_t missed = IRR_NEVER;
+  for (uint32_t t = nextAfter(last_fired, &w); t <= now;
+       t = nextAfter(t, &w)) {
+    if (missed != IRR_NEVER) {
+      skipped_count++;
+    }
+    missed = t;
+    missed_window = w;
+  }
+
+  if (missed != IRR_NEVER) {
+    if (now - missed < config.catchup_min * 60UL) {
+      catchup_window = missed_window;
+    } else {
+      skipped_count++;
+    }
+    last_fired = missed;
+    saveLastFired();
+  }
+
+  next_fire = nextAfter(now, &next_window);
+}
+
+/**
+ * keep the last fired time across a power loss, once per slot
+ * @method saveLastFired
+ */
+void IrrigationSchedule::saveLastFired(void) {
+  irr_state_t state;
+  state.last_fired = last_fired;
+  state.checksum =
+      checksum((const uint8_t *)&state, offsetof(irr_state_t, checksum));
+  EEPROM.put(IRR_STATE_ADDR, state);
+}
+
+/**
+ * one's complement of the byte sum
+ * @method checksum
+ */
+uint8_t IrrigationSchedule::checksum(const uint8_t *data, uint16_t len) {
+  uint8_t sum = 0;
+  while (len--) {
+    sum += *data++;
+  }
+  return ~sum;
+}
+
+/**
+ * check header, checksum and ranges
+ * @method valid
+ */
+bool IrrigationSchedule::valid(const irr_config_t *config) {
+  if ((config->magic != IRR_MAGIC) || (config->version != IRR_VERSION) ||
+      (config->window_count > IRR_MAX_WINDOWS) || (config->zone_count == 0) ||
+      (config->zone_count > IRR_MAX_ZONES) ||
+      (checksum((const uint8_t *)config, offsetof(irr_config_t, checksum)) !=
+       config->checksum)) {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < config->window_count; i++) {
+    const irr_window_t *w = &config->windows[i];
+    // every_min under a day also keeps the 16-bit slot arithmetic of
+    // nextAfter from wrapping
+    if ((w->start_min >= MINUTES_PER_DAY) || (w->end_min >= MINUTES_PER_DAY) ||
+        (w->every_min >= MINUTES_PER_DAY) || (w->zone >= config->zone_count) ||
+        (w->every_min && (w->start_min > w->end_min))) {
+      return false;
+    }
+  }
+  return true;
+}
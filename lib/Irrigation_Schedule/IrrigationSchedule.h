@@ -0,0 +1,105 @@
+#ifndef IRRIGATIONSCHEDULE_H
+#define IRRIGATIONSCHEDULE_H
+
+#if ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+// table size
+#ifndef IRR_MAX_WINDOWS
+#define IRR_MAX_WINDOWS 8
+#endif
+#ifndef IRR_MAX_ZONES
+#define IRR_MAX_ZONES 4
+#endif
+
+// eeprom location of the config, the last fired time is stored right after
+#ifndef IRR_EEPROM_ADDR
+#define IRR_EEPROM_ADDR 0
+#endif
+
+#define IRR_MAGIC 0x5349
+#define IRR_VERSION 1
+
+// no slot
+#define IRR_NO_WINDOW -1
+#define IRR_NEVER 0xFFFFFFFFUL
+
+// day of week mask, bit 0 is monday
+#define IRR_MONDAY 0x01
+#define IRR_TUESDAY 0x02
+#define IRR_WEDNESDAY 0x04
+#define IRR_THURSDAY 0x08
+#define IRR_FRIDAY 0x10
+#define IRR_SATURDAY 0x20
+#define IRR_SUNDAY 0x40
+#define IRR_EVERY_DAY 0x7F
+
+// one time window, starts at start_min then every every_min until end_min,
+// all in minutes of the day, start_min <= end_min. every_min 0 is a single
+// start, otherwise it is under a day.
+typedef struct {
+  uint16_t start_min;
+  uint16_t end_min;
+  uint16_t every_min;
+  uint8_t dow_mask;
+  uint8_t zone;
+} irr_window_t;
+
+// zone parameters, applied to the fuzzy duration
+typedef struct {
+  uint8_t scale_pct;     // duration scale, 100 is the fuzzy duration as is
+  uint8_t max_min;       // duration cap in minutes, 0 for none
+} irr_zone_t;
+
+// eeprom image
+typedef struct {
+  uint16_t magic;
+  uint8_t version;
+  uint8_t window_count;
+  uint8_t zone_count;
+  uint8_t catchup_min;   // a slot missed by less than this still runs
+  irr_zone_t zones[IRR_MAX_ZONES];
+  irr_window_t windows[IRR_MAX_WINDOWS];
+  uint8_t checksum;
+} irr_config_t;
+
+// irrigation schedule over local standard time (the rtc time, no dst), in
+// seconds since 1970 as returned by DS3231::getUnixTime. the next fire time
+// is computed once, when the schedule starts or a slot fires, so the loop
+// only compares two integers or waits on the rtc alarm.
+// the last fired slot is kept in eeprom, at start a slot missed while the
+// power was off runs late if it is recent enough, older ones are dropped.
+class IrrigationSchedule {
+public:
+  IrrigationSchedule();
+  void begin(uint32_t now);
+
+  bool setConfig(const irr_config_t *config, uint32_t now);
+  void getConfig(irr_config_t *config);
+  static void defaultConfig(irr_config_t *config);
+
+  uint32_t next(void);
+  bool due(uint32_t now);
+  int8_t fire(uint32_t now);
+  int8_t catchup(void);
+  uint16_t skipped(void);
+
+  float duration(int8_t window, float duration_min);
+
+private:
+  irr_config_t config;
+  uint32_t last_fired, next_fire;
+  int8_t next_window, catchup_window;
+  uint16_t skipped_count;
+
+  uint32_t nextAfter(uint32_t after, int8_t *window);
+  void load(uint32_t now);
+  void saveLastFired(void);
+  static uint8_t checksum(const uint8_t *data, uint16_t len);
+  static bool valid(const irr_config_t *config);
+};
+
+#endif
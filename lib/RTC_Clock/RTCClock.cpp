@@ -0,0 +1,182 @@
+#include "RTCClock.h"
+
+static const uint8_t days_in_month[] = {31, 28, 31, 30, 31, 30,
+                                        31, 31, 30, 31, 30, 31};
+
+volatile uint8_t RTCClock::sqw_ticks = 0;
+
+// detail implementation
+// init class
+RTCClock::RTCClock(DS3231 *rtc, uint32_t resync_period) {
+  this->rtc = rtc;
+  this->resync_period = resync_period;
+  use_sqw = false;
+  sync_pending = false;
+  unix_now = 0;
+  temperature = NAN;
+  t_last_sync = t_last_tick = 0;
+}
+
+/**
+ * first read of the rtc, the rtc must already be started
+ * @method begin
+ */
+void RTCClock::begin(void) { sync(); }
+
+/**
+ * count seconds on the rtc 1 Hz square wave instead of millis(), the
+ * seconds then stay in phase with the rtc. the sqw output can not be used
+ * together with the rtc alarm interrupt.
+ * @method beginSQW
+ * @param  pin      pin wired to the rtc INT/SQW output
+ * @return          false if the pin has no external interrupt
+ */
+bool RTCClock::beginSQW(uint8_t pin) {
+  int irq = digitalPinToInterrupt(pin);
+  if (irq == NOT_AN_INTERRUPT) {
+    return false;
+  }
+
+  // open drain output
+  pinMode(pin, INPUT_PULLUP);
+  rtc->setSQWRate(SQW_RATE_1);
+  rtc->setOutput(OUTPUT_SQW);
+
+  sync();
+  // the seconds register changes on the falling edge
+  attachInterrupt(irq, sqwISR, FALLING);
+  use_sqw = true;
+  return true;
+}
+
+/**
+ * read the rtc now and restart counting from there
+ * @method sync
+ */
+void RTCClock::sync(void) {
+  DS3231Snapshot snap;
+  rtc->getSnapshot(&snap);
+  setSnapshot(&snap);
+}
+
+/**
+ * restart counting from a snapshot just read from the rtc, the time and die
+ * temperature come from the same burst
+ * @method setSnapshot
+ */
+void RTCClock::setSnapshot(DS3231Snapshot *snap) {
+  now = snap->time;
+  temperature = snap->temperature;
+  unix_now = rtc->getUnixTime(now);
+  t_last_sync = t_last_tick = millis();
+  sync_pending = false;
+
+  // edges before the read are already counted in it
+  noInterrupts();
+  sqw_ticks = 0;
+  interrupts();
+}
+
+/**
+ * advance the clock, call it on every loop pass
+ * @method update
+ */
+void RTCClock::update(void) {
+  uint32_t t_now = millis();
+
+#if defined(DS3231_ASYNC_TWI)
+  if (sync_pending && rtc->timeReady()) {
+    DS3231Snapshot snap;
+    rtc->getAsyncSnapshot(&snap);
+    setSnapshot(&snap);
+    return;
+  }
+  if (!sync_pending && (t_now - t_last_sync >= resync_period)) {
+    // keep ticking from millis until the read completes, a failed read is
+    // retried at the next update
+    sync_pending = rtc->startGetSnapshot();
+  } else if (sync_pending && !rtc->asyncBusy() && !rtc->timeReady()) {
+    sync_pending = false;
+  }
+#else
+  if (t_now - t_last_sync >= resync_period) {
+    sync();
+    return;
+  }
+#endif
+
+  if (use_sqw) {
+    noInterrupts();
+    uint8_t ticks = sqw_ticks;
+    sqw_ticks = 0;
+    interrupts();
+    while (ticks--) {
+      tick();
+    }
+  } else {
+    while (t_now - t_last_tick >= 1000) {
+      t_last_tick += 1000;
+      tick();
+    }
+  }
+}
+
+/**
+ * current time, no i2c
+ * @method getTime
+ */
+Time RTCClock::getTime(void) { return now; }
+
+/**
+ * current unix time, no i2c
+ * @method getUnixTime
+ */
+uint32_t RTCClock::getUnixTime(void) { return unix_now; }
+
+/**
+ * rtc die temperature from the last sync, no i2c
+ * @method getTemperature
+ */
+float RTCClock::getTemperature(void) { return temperature; }
+
+/**
+ * add one second to the cached time
+ * @method tick
+ */
+void RTCClock::tick(void) {
+  unix_now++;
+  if (++now.sec < 60) {
+    return;
+  }
+  now.sec = 0;
+  if (++now.min < 60) {
+    return;
+  }
+  now.min = 0;
+  if (++now.hour < 24) {
+    return;
+  }
+  now.hour = 0;
+
+  now.dow = (now.dow % 7) + 1;
+  uint8_t dim = days_in_month[now.mon - 1];
+  // same leap year rule as the rtc, valid from 2000 to 2099
+  if ((now.mon == 2) && ((now.year % 4) == 0)) {
+    dim++;
+  }
+  if (++now.date <= dim) {
+    return;
+  }
+  now.date = 1;
+  if (++now.mon <= 12) {
+    return;
+  }
+  now.mon = 1;
+  now.year++;
+}
+
+/**
+ * rtc square wave falling edge
+ * @method sqwISR
+ */
+void RTCClock::sqwISR(void) { sqw_ticks++; }
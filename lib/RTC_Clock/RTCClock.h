@@ -0,0 +1,48 @@
+#ifndef RTCCLOCK_H
+#define RTCCLOCK_H
+
+#if ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include <DS3231.h>
+
+// default time between two rtc read
+#define RTC_CLOCK_RESYNC_PERIOD 3600000UL
+
+// software clock over the ds3231. the rtc is read once at begin and then at
+// every resync period, in between the time advances from millis() or from
+// the rtc 1 Hz square wave, so getTime and getUnixTime never touch i2c.
+// with DS3231_ASYNC_TWI the periodic resync is an interrupt driven read, the
+// loop keeps running while the bus transfers.
+class RTCClock {
+public:
+  RTCClock(DS3231 *rtc, uint32_t resync_period = RTC_CLOCK_RESYNC_PERIOD);
+  void begin(void);
+  bool beginSQW(uint8_t pin);
+  void update(void);
+  void sync(void);
+
+  Time getTime(void);
+  uint32_t getUnixTime(void);
+  float getTemperature(void);
+
+private:
+  DS3231 *rtc;
+  uint32_t resync_period, t_last_sync, t_last_tick;
+  bool use_sqw;
+  bool sync_pending;
+
+  Time now;
+  uint32_t unix_now;
+  float temperature;
+
+  void tick(void);
+  void setSnapshot(DS3231Snapshot *snap);
+  static void sqwISR(void);
+  static volatile uint8_t sqw_ticks;
+};
+
+#endif
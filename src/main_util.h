@@ -9,28 +9,41 @@
 
 // dht sensor
 #include "dht_util.h"
+#include <DHTBus.h>
+#include <DHTFilter.h>
 #include <DHT.h>
 
 // rtc
 #include <DS3231.h>
+#include <RTCClock.h>
 
 // fuzzy
 #include <FuzzyDHT.h>
 
+// task
+#include <CoopScheduler.h>
+#include <IrrigationSchedule.h>
+
 // debug port
 #define APP_PORT_DEBUG Serial
 
 // pin setting
 #define PIN_DHT 2
 #define PIN_RELAY A3
+#define PIN_RTC_INT 3
+
+// how long a slot waits for valid dht data
+#define SLOT_GRACE_TIME 10000
 
 // global var
 // rtc
 DS3231 rtc(SDA, SCL);
+RTCClock rtc_clock(&rtc);
 
 // dht sensor
-DHT dht_sensor(PIN_DHT, DHT11);
+DHT dht_sensor(PIN_DHT, DHT_AUTO);
 dht_data_t dht_sensor_output = {0};
+DHTFilter dht_filter;
 
 // fuzzy object
 FuzzyDHT *fuzzy_main_obj = new FuzzyDHT();
@@ -41,10 +54,32 @@ LiquidCrystal lcd_obj(8, 9, 4, 5, 6, 7); // Creates an LC object. Parameters:
                                          // (rs, enable, d4, d5, d6, d7) , rw
                                          // to ground
 
+// task period, ms
+#define TASK_PERIOD_DHT 5000
+#define TASK_PERIOD_DHT_POLL 2
+#define TASK_PERIOD_LCD 1000
+#define TASK_PERIOD_RELAY 1000
+#define TASK_PERIOD_FUZZY 100
+#define TASK_PERIOD_CLOCK 100
+#define TASK_PERIOD_SERIAL 50
+
+// dht bus, one sensor per bed, read round robin
+DHTBus dht_bus(TASK_PERIOD_DHT);
+
+// scheduler
+CoopScheduler scheduler;
+int8_t task_dht = SCHED_NO_TASK;
+
 // timing var
-uint32_t t_now, t_last_dht_acquired, t_last_fuzzy, t_last_lcd_display;
+uint32_t t_now;
 uint32_t t_relay_start_on = 0;
 
+// irrigation slot, the table is in eeprom, see IrrigationSchedule
+IrrigationSchedule irr_schedule;
+volatile uint8_t rtc_alarm_fired = 0;
+int8_t slot_pending = IRR_NO_WINDOW;
+uint32_t t_slot_start;
+
 /**
  * debug printing util
  * @method APP_DEBUG_PRINT
@@ -82,11 +117,12 @@ void lcd_init() {
  */
 void lcd_print_data(LiquidCrystal *lcdx, Time atime, dht_data_t dht_data_out,
                     float dur_on) {
-  // show datetime
+  // show datetime, dd-mm-yyyy hh:mm with blinking colon
   char dtx[18] = {0};
-  snprintf_P(dtx, sizeof(dtx), (const char *)F("%02d-%02d-%04d %02d%c%02d"),
-             atime.date, atime.mon, atime.year, atime.hour,
-             (atime.sec % 2) ? ' ' : ':', atime.min);
+  ds3231_format_date(atime, dtx, FORMAT_LONG, FORMAT_LITTLEENDIAN, '-');
+  dtx[10] = ' ';
+  ds3231_format_time(atime, &dtx[11], FORMAT_SHORT);
+  dtx[13] = (atime.sec % 2) ? ' ' : ':';
   lcdx->setCursor(0, 0);
   lcdx->print(dtx);
 
@@ -104,34 +140,94 @@ void lcd_print_data(LiquidCrystal *lcdx, Time atime, dht_data_t dht_data_out,
 }
 
 /**
- * processing fuzzy way
+ * rtc alarm interrupt, INT output is active low
+ * @method rtcAlarmISR
+ */
+void rtcAlarmISR() { rtc_alarm_fired = 1; }
+
+/**
+ * program rtc alarm 1 for the next irrigation slot
+ * @method scheduleNextSlot
+ */
+void scheduleNextSlot() {
+  uint32_t t_next = irr_schedule.next();
+  if (t_next == IRR_NEVER) {
+    rtc.enableAlarm(ALARM_1, false);
+    APP_DEBUG_PRINT(F("NO SLOT"));
+    return;
+  }
+
+  Time tx = rtc.getTimeFromUnix(t_next);
+  rtc.setAlarm1(ALARM1_MATCH_DATE, tx.date, tx.hour, tx.min, tx.sec);
+  rtc.enableAlarm(ALARM_1, true);
+
+  char dtx[DS3231_DATE_STR_SIZE + DS3231_TIME_STR_SIZE];
+  ds3231_format_date(tx, dtx);
+  dtx[DS3231_DATE_STR_SIZE - 1] = ' ';
+  ds3231_format_time(tx, &dtx[DS3231_DATE_STR_SIZE]);
+  APP_DEBUG_PRINT(String("NEXT SLOT = ") + String(dtx));
+}
+
+/**
+ * init rtc alarm interrupt
+ * @method alarmInit
+ */
+void alarmInit() {
+  irr_schedule.begin(rtc_clock.getUnixTime());
+
+  pinMode(PIN_RTC_INT, INPUT_PULLUP);
+  rtc.clearAlarm(ALARM_1);
+  scheduleNextSlot();
+  attachInterrupt(digitalPinToInterrupt(PIN_RTC_INT), rtcAlarmISR, FALLING);
+
+  // a slot missed while the power was off, run it now if still recent
+  slot_pending = irr_schedule.catchup();
+  if (slot_pending != IRR_NO_WINDOW) {
+    t_slot_start = millis();
+    APP_DEBUG_PRINT(F("SLOT CATCHUP"));
+  }
+  if (irr_schedule.skipped()) {
+    APP_DEBUG_PRINT(String("SLOT MISSED = ") +
+                    String(irr_schedule.skipped()));
+  }
+}
+
+/**
+ * processing fuzzy way, once per irrigation slot
  * @method processFuzzySystem
  */
 void processFuzzySystem() {
-  Time tx = rtc.getTime();
-
-  // do fuzzy
-  // fuzzy_main_obj->update(dht_sensor_output.temperature,
-  //                        dht_sensor_output.humidity);
-
-  // 7 to 15, per 2 hours
-  if ((tx.hour >= 7) && (tx.hour <= 15) && (tx.hour % 2 == 1)) {
-    if (tx.min <= 0) {
-      if (tx.sec <= (5 + (dht_sensor_output.status_ok * 5))) {
-        // process it
-        // process input if is valid
-        if (dht_sensor_output.status_ok) {
-          fuzzy_main_obj->update(dht_sensor_output.temperature,
-                                 dht_sensor_output.humidity);
-          duration_siram_active = fuzzy_main_obj->duration_out;
-
-          t_relay_start_on = rtc.getUnixTime(rtc.getTime());
-
-          // APP_DEBUG_PRINT(String("DURATION = ") +
-          //                 String(fuzzy_main_obj->duration_out));
-        }
-      }
-    }
+  if (rtc_alarm_fired) {
+    rtc_alarm_fired = 0;
+    rtc.clearAlarm(ALARM_1);
+    rtc_clock.sync();
+  }
+
+  // the alarm wakes us on time, the compare also covers a lost alarm
+  uint32_t tick_n = rtc_clock.getUnixTime();
+  if (irr_schedule.due(tick_n)) {
+    slot_pending = irr_schedule.fire(tick_n);
+    t_slot_start = t_now;
+    scheduleNextSlot();
+  }
+
+  if (slot_pending == IRR_NO_WINDOW) {
+    return;
+  }
+
+  // duration_out follows the filtered sensor value, see processDHTSensor
+  if (dht_sensor_output.status_ok) {
+    duration_siram_active =
+        irr_schedule.duration(slot_pending, fuzzy_main_obj->duration_out);
+    t_relay_start_on = rtc_clock.getUnixTime();
+    slot_pending = IRR_NO_WINDOW;
+
+    APP_DEBUG_PRINT(String("SLOT DURATION = ") +
+                    String(duration_siram_active * 60.0));
+  } else if (t_now - t_slot_start >= SLOT_GRACE_TIME) {
+    // no valid data, skip this slot
+    slot_pending = IRR_NO_WINDOW;
+    APP_DEBUG_PRINT(F("SLOT SKIPPED"));
   }
 }
 
@@ -140,7 +236,7 @@ void processFuzzySystem() {
  * @method processRelayOnOff
  */
 void processRelayOnOff() {
-  uint32_t tick_n = rtc.getUnixTime(rtc.getTime());
+  uint32_t tick_n = rtc_clock.getUnixTime();
 
   digitalWrite(PIN_RELAY, ((duration_siram_active > 0.0) &&
                            ((tick_n - t_relay_start_on) <=
@@ -152,38 +248,120 @@ void processRelayOnOff() {
  * @method processLCDDisplayData
  */
 void processLCDDisplayData() {
-  if (t_now - t_last_lcd_display >= 1000) {
-    t_last_lcd_display = t_now;
-    Time tx = rtc.getTime();
-    lcd_print_data(&lcd_obj, tx, dht_sensor_output,
-                   fuzzy_main_obj->duration_out * 60.0);
-
-    APP_DEBUG_PRINT(rtc.getDateStr() + String(" ") + rtc.getTimeStr());
-  }
+  Time tx = rtc_clock.getTime();
+  lcd_print_data(&lcd_obj, tx, dht_sensor_output,
+                 fuzzy_main_obj->duration_out * 60.0);
+
+  // same text as getDateStr and getTimeStr, from the cached time
+  char dtx[DS3231_DATE_STR_SIZE + DS3231_TIME_STR_SIZE];
+  ds3231_format_date(tx, dtx);
+  dtx[DS3231_DATE_STR_SIZE - 1] = ' ';
+  ds3231_format_time(tx, &dtx[DS3231_DATE_STR_SIZE]);
+  APP_DEBUG_PRINT(dtx + String(" RTC TEMP = ") +
+                  String(rtc_clock.getTemperature()));
 }
 
 /**
- * get dht data sensor
+ * get dht data sensor from the bus, the acquisition runs in the background so
+ * the loop keeps serving the lcd and relay while the sensor sends its frame
  * @method processDHTSensor
+ * @return  1 while the acquisition is still running
  */
-void processDHTSensor() {
-  if (t_now - t_last_dht_acquired >= 5000) {
-    t_last_dht_acquired = t_now;
-    get_dht_data(&dht_sensor, &dht_sensor_output);
-
-    if (!dht_sensor_output.status_ok) {
-      APP_DEBUG_PRINT(F("DHT ERROR"));
-    } else {
+uint8_t processDHTSensor() {
+  dht_bus.update();
+
+  dht_bus_sample_t sample;
+  while (dht_bus.read(&sample)) {
+    // errors are counted by the driver, see processSerialCommand
+    dht_sensor_output.status_ok = sample.status_ok;
+    if (!sample.status_ok) {
+      continue;
+    }
+    dht_sensor_output.temperature = sample.temperature;
+    dht_sensor_output.humidity = sample.humidity;
+
+    bool changed = dht_filter.update(dht_sensor_output.temperature,
+                                     dht_sensor_output.humidity);
+    // from the filtered values, the same the fuzzy system sees
+    dht_sensor_output.heat_index =
+        dht_heat_index(dht_sensor_output.temperature,
+                       dht_sensor_output.humidity, false);
+
+    if (changed) {
+      // fuzzy only run again when the filtered value really changed
       fuzzy_main_obj->update(dht_sensor_output.temperature,
                              dht_sensor_output.humidity);
 
       APP_DEBUG_PRINT(String("TEMP = ") +
                       String(dht_sensor_output.temperature));
-      APP_DEBUG_PRINT(String("HUM  = ") + String(dht_sensor_output.humidity));
+      APP_DEBUG_PRINT(String("HUM  = ") +
+                      String(dht_sensor_output.humidity));
       APP_DEBUG_PRINT(String("DURATION = ") +
                       String(fuzzy_main_obj->duration_out * 60.0));
     }
   }
+  return dht_bus.busy();
+}
+
+/**
+ * dht task, polled every few ms while the acquisition runs and then again
+ * one period later
+ * @method taskDHTSensor
+ */
+void taskDHTSensor() {
+  if (processDHTSensor()) {
+    scheduler.runIn(task_dht, TASK_PERIOD_DHT_POLL);
+  }
+}
+
+/**
+ * software clock task
+ * @method taskClock
+ */
+void taskClock() { rtc_clock.update(); }
+
+/**
+ * answer request from the debug port, all binary, little endian, no padding
+ * on avr.
+ * 'S' : 'S', struct size, dht_stats_t
+ * 'T' : 'T', task count, struct size, idle us, busy us (uint32),
+ *       then one sched_stats_t per task in the order they were added
+ * @method processSerialCommand
+ */
+void processSerialCommand() {
+  if (!APP_PORT_DEBUG.available()) {
+    return;
+  }
+
+  switch (APP_PORT_DEBUG.read()) {
+  case 'S': {
+    dht_stats_t stats;
+    dht_sensor.getStats(&stats);
+    APP_PORT_DEBUG.write('S');
+    APP_PORT_DEBUG.write((uint8_t)sizeof(stats));
+    APP_PORT_DEBUG.write((const uint8_t *)&stats, sizeof(stats));
+    break;
+  }
+  case 'T': {
+    sched_stats_t stats;
+    uint8_t count = 0;
+    while (scheduler.getStats(count, &stats)) {
+      count++;
+    }
+    uint32_t idle_us = scheduler.idleTime();
+    uint32_t busy_us = scheduler.busyTime();
+    APP_PORT_DEBUG.write('T');
+    APP_PORT_DEBUG.write(count);
+    APP_PORT_DEBUG.write((uint8_t)sizeof(stats));
+    APP_PORT_DEBUG.write((const uint8_t *)&idle_us, sizeof(idle_us));
+    APP_PORT_DEBUG.write((const uint8_t *)&busy_us, sizeof(busy_us));
+    for (uint8_t i = 0; i < count; i++) {
+      scheduler.getStats(i, &stats);
+      APP_PORT_DEBUG.write((const uint8_t *)&stats, sizeof(stats));
+    }
+    break;
+  }
+  }
 }
 
 /**
@@ -239,16 +417,21 @@ void main_app_setup() {
 
   // rtc up
   rtc.begin();
+  rtc_clock.begin();
+  alarmInit();
   // APP_DEBUG_PRINT(String(rtc.getUnixTime(rtc.getTime())));
   // setup datetime
   // rtc.setDate(13, 5, 2017);
   // rtc.setTime(15, 51, 0);
 
-  // dht up
-  dht_sensor.begin();
+  // dht up, the sensor pin needs an edge interrupt
+  if (!dht_bus.addSensor(&dht_sensor)) {
+    APP_DEBUG_PRINT(F("DHT PIN NO INT"));
+  }
+  dht_bus.begin();
 
   // init timing
-  t_now = t_last_dht_acquired = t_last_fuzzy = t_last_lcd_display = millis();
+  t_now = millis();
 
   // init fuzzy
   fuzzy_main_obj->begin();
@@ -256,37 +439,22 @@ void main_app_setup() {
   APP_DEBUG_PRINT(F("INIT DONE"));
 
   debugTest();
+
+  // task, relay and irrigation slot first
+  scheduler.addTask(processFuzzySystem, TASK_PERIOD_FUZZY, 3);
+  scheduler.addTask(processRelayOnOff, TASK_PERIOD_RELAY, 3);
+  scheduler.addTask(taskClock, TASK_PERIOD_CLOCK, 2);
+  task_dht = scheduler.addTask(taskDHTSensor, TASK_PERIOD_DHT, 1,
+                               TASK_PERIOD_DHT);
+  scheduler.addTask(processLCDDisplayData, TASK_PERIOD_LCD, 0);
+  scheduler.addTask(processSerialCommand, TASK_PERIOD_SERIAL, 0);
 }
 
 void main_app_loop() {
-  // current time
+  // current time, the process function read it
   t_now = millis();
 
-  // display to lcd per 1sec
-  processLCDDisplayData();
-
-  // dht last time
-  processDHTSensor();
-
-  // time to process
-  processFuzzySystem();
-
-  // relay on or off
-  processRelayOnOff();
-
-  // time to process
-
-  // fuzzy last time
-  // if (t_now - t_last_fuzzy >= 5000) {
-  //   t_last_fuzzy = t_now;
-  //
-  //   // process input if is valid
-  //   if (dht_sensor_output.status_ok) {
-  //     fuzzyProcessInput(dht_sensor_output.temperature,
-  //                       dht_sensor_output.humidity, &fuzzy_duration_out);
-  //
-  //     APP_DEBUG_PRINT(String(fuzzy_duration_out));
-  //   }
-  // }
+  // run the next due task or wait for it
+  scheduler.loop();
 }
 #endif
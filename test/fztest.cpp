@@ -26,8 +26,10 @@ void setup() {
 }
 
 void loop() {
-  get_dht_data(&dht_sensor, &dht_sensor_output);
-  myfuzzy->update(dht_sensor_output.temperature, dht_sensor_output.humidity);
+  if (wait_dht_data(&dht_sensor, &dht_sensor_output, DHT_DATA_WAIT_TIMEOUT) ==
+      DHT_DATA_OK) {
+    myfuzzy->update(dht_sensor_output.temperature, dht_sensor_output.humidity);
+  }
 
   delay(5000);
 }
@@ -0,0 +1,37 @@
+// Minimal stand-in for the Arduino core in host builds of the libraries
+// (ARDUINO=100, this directory on the include path). millis() and micros()
+// read a fake clock that only moves when the test moves it, a task can also
+// move it to take time.
+
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+// the fake clock in microseconds, one instance across translation units
+inline uint64_t &arduino_fake_us(void) {
+  static uint64_t t_us = 0;
+  return t_us;
+}
+
+inline uint32_t millis(void) { return (uint32_t)(arduino_fake_us() / 1000); }
+inline uint32_t micros(void) { return (uint32_t)arduino_fake_us(); }
+
+// set the clock, millis() reads ms from now on
+inline void arduino_set_millis(uint32_t ms) {
+  arduino_fake_us() = (uint64_t)ms * 1000;
+}
+
+inline void arduino_advance_millis(uint32_t ms) {
+  arduino_fake_us() += (uint64_t)ms * 1000;
+}
+
+inline void arduino_advance_micros(uint32_t us) { arduino_fake_us() += us; }
+
+#endif
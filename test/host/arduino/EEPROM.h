@@ -0,0 +1,46 @@
+// Minimal stand-in for the Arduino EEPROM library in host builds, 1 KB
+// (the uno size) in memory, erased to 0xFF at the start.
+
+#ifndef EEPROM_H
+#define EEPROM_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define EEPROM_SIZE 1024
+
+// the memory, one instance across translation units
+inline uint8_t *arduino_eeprom(void) {
+  static uint8_t mem[EEPROM_SIZE];
+  static bool erased = false;
+  if (!erased) {
+    memset(mem, 0xFF, sizeof(mem));
+    erased = true;
+  }
+  return mem;
+}
+
+inline void arduino_eeprom_erase(void) {
+  memset(arduino_eeprom(), 0xFF, EEPROM_SIZE);
+}
+
+struct EEPROMClass {
+  uint8_t read(int idx) { return arduino_eeprom()[idx]; }
+  void write(int idx, uint8_t val) { arduino_eeprom()[idx] = val; }
+  void update(int idx, uint8_t val) { write(idx, val); }
+  uint16_t length(void) { return EEPROM_SIZE; }
+
+  template <typename T> T &get(int idx, T &t) {
+    memcpy((void *)&t, arduino_eeprom() + idx, sizeof(T));
+    return t;
+  }
+  template <typename T> const T &put(int idx, const T &t) {
+    memcpy(arduino_eeprom() + idx, (const void *)&t, sizeof(T));
+    return t;
+  }
+};
+
+// stateless, as in the AVR core
+static EEPROMClass EEPROM __attribute__((unused));
+
+#endif
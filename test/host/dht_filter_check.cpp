@@ -0,0 +1,275 @@
+// Behaviour and cost check for lib/DHT_Filter.
+//
+// SensorFilter is run on random sequences with spikes, steps and non-finite
+// samples next to a plain model of its three stages (rate of change
+// rejection, median of the last accepted samples, ema) and must give the
+// same bits and the same accept/reject answers. A few fixed sequences check
+// the documented cases: a spike is dropped, a step that stays is taken after
+// DHT_FILTER_MAX_REJECT samples, nan and inf change nothing. DHTFilter must
+// report a change only past its thresholds. The cost of one DHTFilter update
+// is then timed.
+//
+//   dht_filter_check [-n sequences] [-s seed] [-t seconds]
+//
+// The exit status is 1 when a check fails.
+
+#include <DHTFilter.h>
+
+#include <chrono>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// samples per random sequence
+#define SEQUENCE_LEN 200
+
+static uint64_t failures = 0;
+
+#define CHECK(cond, ...)                                                       \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      if (failures++ < 10) {                                                   \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__);                            \
+        printf(__VA_ARGS__);                                                   \
+        printf("\n");                                                          \
+      }                                                                        \
+    }                                                                          \
+  } while (0)
+
+// xorshift64*, the same sequence on every host
+struct rng_t {
+  uint64_t s;
+  explicit rng_t(uint64_t seed) : s(seed ? seed : 1) {}
+  uint32_t next() {
+    s ^= s >> 12;
+    s ^= s << 25;
+    s ^= s >> 27;
+    return (uint32_t)((s * 0x2545F4914F6CDD1DULL) >> 32);
+  }
+  int range(int n) { return (int)(next() % (uint32_t)n); }
+  float uniform(float lo, float hi) { return lo + (hi - lo) * (next() >> 8) * (1.0f / 16777216.0f); }
+};
+
+// the filter as documented, written without the ring buffer
+struct model_t {
+  float max_step, alpha;
+  float accepted[DHT_FILTER_WINDOW];
+  int used, rejects;
+  float last, ema;
+
+  model_t(float max_step, float alpha) : max_step(max_step), alpha(alpha) { reset(); }
+
+  void reset() {
+    used = rejects = 0;
+    last = ema = 0.0f;
+  }
+
+  bool update(float x) {
+    if (isnan(x) || isinf(x)) {
+      return false;
+    }
+    if (used && (max_step > 0.0f) && (fabs(x - last) > max_step)) {
+      if (++rejects < DHT_FILTER_MAX_REJECT) {
+        return false;
+      }
+      reset();
+    }
+    rejects = 0;
+    last = x;
+    if (used == DHT_FILTER_WINDOW) {
+      memmove(accepted, accepted + 1, sizeof(float) * (DHT_FILTER_WINDOW - 1));
+      used--;
+    }
+    accepted[used++] = x;
+
+    // the element at used / 2 in sorted order, found by counting
+    float m = accepted[0];
+    for (int i = 0; i < used; i++) {
+      int less = 0, equal = 0;
+      for (int j = 0; j < used; j++) {
+        less += accepted[j] < accepted[i];
+        equal += accepted[j] == accepted[i];
+      }
+      if ((less <= used / 2) && (used / 2 < less + equal)) {
+        m = accepted[i];
+      }
+    }
+    ema = ((used == 1) || (alpha >= 1.0f)) ? m : ema + alpha * (m - ema);
+    return true;
+  }
+};
+
+static float random_sample(rng_t &rng, float &level, float step) {
+  switch (rng.range(20)) {
+  case 0:
+    // spike
+    return level + (rng.range(2) ? 1 : -1) * step * rng.uniform(1.5f, 4.0f);
+  case 1:
+    // step that stays
+    level += (rng.range(2) ? 1 : -1) * step * rng.uniform(1.5f, 4.0f);
+    return level;
+  case 2: {
+    static const float bad[] = {NAN, INFINITY, -INFINITY};
+    return bad[rng.range(3)];
+  }
+  default:
+    level += rng.uniform(-0.3f, 0.3f) * step;
+    return level + rng.uniform(-0.1f, 0.1f) * step;
+  }
+}
+
+static void check_against_model(uint64_t seed, uint64_t sequences) {
+  static const float settings[][2] = {
+      {DHT_FILTER_TEMP_STEP, DHT_FILTER_TEMP_ALPHA},
+      {DHT_FILTER_HUM_STEP, DHT_FILTER_HUM_ALPHA},
+      {0.0f, 0.3f}, // no rejection
+      {2.0f, 1.0f}, // no ema
+  };
+  uint64_t samples = 0, rejected = 0;
+
+  for (uint64_t c = 0; c < sequences; c++) {
+    rng_t rng(seed ^ (c * 0x9E3779B97F4A7C15ULL));
+    const float *set = settings[c % 4];
+    float step = (set[0] > 0) ? set[0] : 5.0f;
+    SensorFilter f(set[0], set[1]);
+    model_t m(set[0], set[1]);
+    float level = rng.uniform(-10, 90);
+
+    for (int i = 0; i < SEQUENCE_LEN; i++) {
+      float x = random_sample(rng, level, step);
+      bool got = f.update(x), want = m.update(x);
+      float v = f.value();
+      samples++;
+      rejected += !want;
+      CHECK(got == want, "sequence %llu sample %d (%g): accepted %d, expected %d",
+            (unsigned long long)c, i, x, got, want);
+      CHECK(memcmp(&v, &m.ema, sizeof(float)) == 0,
+            "sequence %llu sample %d (%g): value %.9g, expected %.9g", (unsigned long long)c,
+            i, x, v, m.ema);
+      CHECK(isfinite(v), "sequence %llu sample %d: value %g", (unsigned long long)c, i, v);
+      CHECK(f.rejected() == m.rejects, "sequence %llu sample %d: %u rejected, expected %d",
+            (unsigned long long)c, i, f.rejected(), m.rejects);
+    }
+  }
+  printf("model: %llu sequences, %llu samples, %llu rejected or not finite\n",
+         (unsigned long long)sequences, (unsigned long long)samples,
+         (unsigned long long)rejected);
+}
+
+static void check_cases(void) {
+  // constant input, every stage leaves it alone
+  SensorFilter f(DHT_FILTER_TEMP_STEP, DHT_FILTER_TEMP_ALPHA);
+  for (int i = 0; i < 10; i++) {
+    CHECK(f.update(25.0f), "constant sample %d rejected", i);
+  }
+  CHECK(f.value() == 25.0f, "constant input filtered to %g", f.value());
+
+  // a single spike is dropped
+  CHECK(!f.update(40.0f), "spike accepted");
+  CHECK(f.rejected() == 1, "spike counted %u times", f.rejected());
+  CHECK(f.update(25.0f), "sample after the spike rejected");
+  CHECK(f.value() == 25.0f, "spike moved the value to %g", f.value());
+
+  // a step that stays restarts the filter on the new level
+  for (int i = 1; i < DHT_FILTER_MAX_REJECT; i++) {
+    CHECK(!f.update(35.0f), "step sample %d accepted early", i);
+  }
+  CHECK(f.update(35.0f), "step not taken after %d samples", DHT_FILTER_MAX_REJECT);
+  CHECK(f.value() == 35.0f, "step restarted at %g", f.value());
+
+  // nan and inf change nothing, not even the reject count
+  f.update(36.0f);
+  float before = f.value();
+  CHECK(!f.update(NAN), "nan accepted");
+  CHECK(!f.update(INFINITY), "inf accepted");
+  CHECK(!f.update(-INFINITY), "-inf accepted");
+  CHECK(f.value() == before, "non-finite sample moved the value to %g", f.value());
+  CHECK(f.rejected() == 0, "non-finite sample counted as a spike");
+  CHECK(f.update(36.0f) && isfinite(f.value()), "filter stuck after nan");
+
+  // nan first, the filter is still empty after it
+  SensorFilter g(DHT_FILTER_TEMP_STEP, DHT_FILTER_TEMP_ALPHA);
+  CHECK(!g.update(NAN), "nan accepted on an empty filter");
+  CHECK(g.update(80.0f) && g.value() == 80.0f, "first sample after nan gives %g", g.value());
+
+  // DHTFilter reports a change only past its thresholds
+  DHTFilter d;
+  float t = 25.0f, h = 60.0f;
+  CHECK(d.update(t, h), "first reading not reported");
+  t = 25.0f + DHT_FILTER_TEMP_CHANGE * 0.5f;
+  h = 60.0f;
+  CHECK(!d.update(t, h), "temperature change under the threshold reported");
+  bool moved = false;
+  for (int i = 0; i < 10 && !moved; i++) {
+    t = 26.0f;
+    h = 60.0f;
+    moved = d.update(t, h);
+  }
+  CHECK(moved, "temperature change over the threshold never reported");
+  // a nan reading gives the last filtered values back
+  float t_before = d.temperature.value(), h_before = d.humidity.value();
+  t = NAN;
+  h = 60.0f;
+  CHECK(!d.update(t, h), "nan reading reported");
+  CHECK(t == t_before && h == h_before, "nan reading gives (%g, %g), expected (%g, %g)", t, h,
+        t_before, h_before);
+
+  // a non-finite reading before any other is left as is
+  DHTFilter e;
+  t = 25.0f;
+  h = INFINITY;
+  CHECK(!e.update(t, h), "first reading with inf reported");
+  t = 25.0f;
+  h = 60.0f;
+  CHECK(e.update(t, h) && t == 25.0f && h == 60.0f, "first finite reading gives (%g, %g)",
+        t, h);
+}
+
+int main(int argc, char **argv) {
+  uint64_t sequences = 20000, seed = 1;
+  double min_secs = 0.3;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-n") && i + 1 < argc) sequences = strtoull(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-s") && i + 1 < argc) seed = strtoull(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-t") && i + 1 < argc) min_secs = atof(argv[++i]);
+    else {
+      fprintf(stderr, "usage: %s [-n sequences] [-s seed] [-t seconds]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  check_cases();
+  check_against_model(seed, sequences);
+
+  // one DHTFilter update per reading, on a slow drift with noise
+  const int n = 4096;
+  static float t_in[n], h_in[n];
+  rng_t rng(seed);
+  for (int j = 0; j < n; j++) {
+    t_in[j] = 25.0f + 5.0f * sinf(j * 0.01f) + rng.uniform(-0.3f, 0.3f);
+    h_in[j] = 60.0f + 20.0f * sinf(j * 0.007f) + rng.uniform(-1.0f, 1.0f);
+  }
+  DHTFilter d;
+  uint64_t done = 0, changes = 0;
+  double secs = 0;
+  float sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  do {
+    for (int j = 0; j < n; j++) {
+      float t = t_in[j], h = h_in[j];
+      changes += d.update(t, h);
+      sink += t;
+    }
+    done += n;
+    secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  } while (secs < min_secs);
+  printf("DHTFilter::update %.1f ns/reading, %.1f%% reported as change (sink %g)\n",
+         secs * 1e9 / done, 100.0 * changes / done, sink);
+
+  if (failures) {
+    printf("FAIL: %llu checks failed\n", (unsigned long long)failures);
+  }
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,176 @@
+// Accuracy and throughput check for lib/DHT/DHT_heat.
+//
+// The Horner kernel (branch-free, or with -DDHT_HEAT_BRANCHES the branchy one
+// AVR builds) is compared on a grid over -40..80 C and 0..100 %RH against the
+// NOAA formula written with pow() terms, once in float (what the library used
+// to compute) and once in double (the exact value of the formula). Points where float and double rounding put the
+// simple formula on different sides of its 79 F switch-over are counted
+// apart, the formula itself jumps there. The batch functions must give the
+// same bits as the scalar ones. The batch and scalar paths are then timed.
+//
+//   dht_heat_check [-g grid_step] [-t seconds]
+//
+// The exit status is 1 when an error goes over the tolerance documented in
+// DHT_heat.h or a batch result differs from the scalar one.
+
+#include <DHT_heat.h>
+
+#include <chrono>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+// tolerances of DHT_heat.h, degrees, against the double formula and against
+// the float pow() one
+#define TOLERANCE_F 0.001
+#define TOLERANCE_C 0.0006
+#define TOLERANCE_F_FLOAT 0.0015
+
+template <typename real> static real reference_f(real t, real h) {
+  real hi = real(0.5) * (t + real(61.0) + ((t - real(68.0)) * real(1.2)) + (h * real(0.094)));
+  if (hi > 79) {
+    hi = real(-42.379) + real(2.04901523) * t + real(10.14333127) * h +
+         real(-0.22475541) * t * h + real(-0.00683783) * pow(t, real(2)) +
+         real(-0.05481717) * pow(h, real(2)) + real(0.00122874) * pow(t, real(2)) * h +
+         real(0.00085282) * t * pow(h, real(2)) +
+         real(-0.00000199) * pow(t, real(2)) * pow(h, real(2));
+    if ((h < 13) && (t >= 80) && (t <= 112)) {
+      hi -= ((real(13.0) - h) * real(0.25)) * sqrt((real(17.0) - fabs(t - real(95.0))) * real(0.05882));
+    } else if ((h > 85) && (t >= 80) && (t <= 87)) {
+      hi += ((h - real(85.0)) * real(0.1)) * ((real(87.0) - t) * real(0.2));
+    }
+  }
+  return hi;
+}
+
+// does the Rothfusz regression apply
+template <typename real> static bool switched(real t, real h) {
+  return real(0.5) * (t + real(61.0) + ((t - real(68.0)) * real(1.2)) + (h * real(0.094))) > 79;
+}
+
+struct error_t {
+  double max_abs, sum_abs;
+  float at_t, at_h;
+  uint64_t count;
+};
+
+static void account(error_t &e, double err, float t, float h) {
+  err = fabs(err);
+  e.sum_abs += err;
+  e.count++;
+  if (err > e.max_abs) {
+    e.max_abs = err;
+    e.at_t = t;
+    e.at_h = h;
+  }
+}
+
+static void print_error(const char *name, const error_t &e, const char *unit) {
+  printf("%-24s max %.6f %s at (%.2f, %.2f %%RH), mean %.7f\n", name, e.max_abs, unit,
+         e.at_t, e.at_h, e.sum_abs / (e.count ? e.count : 1));
+}
+
+int main(int argc, char **argv) {
+  double step = 0.02, min_secs = 0.3;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-g") && i + 1 < argc) step = atof(argv[++i]);
+    else if (!strcmp(argv[i], "-t") && i + 1 < argc) min_secs = atof(argv[++i]);
+    else {
+      fprintf(stderr, "usage: %s [-g grid_step] [-t seconds]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  // one row of humidity per temperature, through the batch functions
+  int rows = (int)(120.0 / step + 1.5), cols = (int)(100.0 / step + 1.5);
+  std::vector<float> tc(cols), tf(cols), hum(cols), out_f(cols), out_c(cols);
+  for (int j = 0; j < cols; j++) {
+    hum[j] = (float)(j * step);
+  }
+
+  error_t f_vs_float, f_vs_double, c_vs_double;
+  memset(&f_vs_float, 0, sizeof(f_vs_float));
+  memset(&f_vs_double, 0, sizeof(f_vs_double));
+  memset(&c_vs_double, 0, sizeof(c_vs_double));
+  uint64_t batch_mismatch = 0, switch_over = 0;
+
+  for (int i = 0; i < rows; i++) {
+    float c = (float)(-40.0 + i * step);
+    float f = dht_c_to_f(c);
+    for (int j = 0; j < cols; j++) {
+      tc[j] = c;
+      tf[j] = f;
+    }
+    dht_heat_index_batch(&tf[0], &hum[0], &out_f[0], cols, true);
+    dht_heat_index_batch(&tc[0], &hum[0], &out_c[0], cols, false);
+
+    for (int j = 0; j < cols; j++) {
+      float h = hum[j];
+      float scalar_f = dht_heat_index(f, h, true);
+      float scalar_c = dht_heat_index(c, h, false);
+      batch_mismatch += memcmp(&scalar_f, &out_f[j], sizeof(float)) != 0;
+      batch_mismatch += memcmp(&scalar_c, &out_c[j], sizeof(float)) != 0;
+
+      account(f_vs_float, (double)out_f[j] - reference_f<float>(f, h), f, h);
+
+      double fd = f, cd = c * 1.8 + 32;
+      if (switched(f, h) != switched(fd, (double)h) ||
+          switched((float)cd, h) != switched(cd, (double)h)) {
+        switch_over++;
+        continue;
+      }
+      account(f_vs_double, (double)out_f[j] - reference_f<double>(fd, h), f, h);
+      // same conversions as the library, in double
+      double exact_c = (reference_f<double>(cd, h) - 32) * 0.55555;
+      account(c_vs_double, (double)out_c[j] - exact_c, c, h);
+    }
+  }
+
+  printf("%d x %d grid, -40..80 C by %g, 0..100 %%RH by %g\n", rows, cols, step, step);
+  print_error("F vs float pow()", f_vs_float, "F");
+  print_error("F vs double pow()", f_vs_double, "F");
+  print_error("C vs double pow()", c_vs_double, "C");
+  printf("switch-over points left out of the double comparison: %llu\n",
+         (unsigned long long)switch_over);
+  printf("batch results differing from scalar: %llu\n", (unsigned long long)batch_mismatch);
+
+  // throughput over one row of the grid, reused
+  const int n = 4096;
+  std::vector<float> t(n), h(n), out(n);
+  for (int j = 0; j < n; j++) {
+    t[j] = (float)(-40.0 + 120.0 * j / n);
+    h[j] = (float)((j * 37) % 1001) * 0.1f;
+  }
+  for (int mode = 0; mode < 2; mode++) {
+    uint64_t done = 0;
+    double secs = 0;
+    float sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    do {
+      if (mode == 0) {
+        dht_heat_index_batch(&t[0], &h[0], &out[0], n, false);
+      } else {
+        for (int j = 0; j < n; j++) {
+          out[j] = dht_heat_index(t[j], h[j], false);
+        }
+      }
+      sink += out[done % n];
+      done += n;
+      secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    } while (secs < min_secs);
+    printf("%-7s %.1f ns/value (sink %g)\n", mode == 0 ? "batch" : "scalar", secs * 1e9 / done,
+           sink);
+  }
+
+  bool fail = (batch_mismatch != 0) || (f_vs_double.max_abs > TOLERANCE_F) ||
+              (f_vs_float.max_abs > TOLERANCE_F_FLOAT) ||
+              (c_vs_double.max_abs > TOLERANCE_C);
+  if (fail) {
+    printf("FAIL: over the tolerance of %g F / %g C (%g F against float) or batch differs\n",
+           TOLERANCE_F, TOLERANCE_C, TOLERANCE_F_FLOAT);
+  }
+  return fail ? 1 : 0;
+}
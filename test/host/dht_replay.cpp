@@ -0,0 +1,197 @@
+// Replay and throughput harness for lib/DHT/DHT_decode.
+//
+// Decodes DHT pulse traces with dht_decode_frame(), the code every capture
+// path of the driver goes through, and classifies each result:
+//
+//   ok        checksum good and, when the trace says what was sent, the
+//             same frame
+//   timeout   a pulse timed out, the driver reports a bit timeout
+//   checksum  40 bits decoded but the checksum is wrong
+//   wrong     checksum good but not the frame that was sent, an error the
+//             driver cannot see
+//
+// Traces come from text files (recorded captures or dht_trace_gen output,
+// "-" is stdin) or, without files, are synthesized in memory with every
+// impairment of dht_trace.h. The whole set is then decoded again in a loop
+// for at least -t seconds to measure the throughput.
+//
+// Before that, dht_classify_frame() is run over every reading a DHT11 or a
+// DHT22 can send, each must come out as its own layout.
+//
+//   dht_replay [-n frames] [-s seed] [-j jitter_us] [-t seconds] [-v] [file...]
+//
+// The exit status is 1 when a clean trace is not decoded to its frame or a
+// reading is classified as the wrong layout.
+
+#include "dht_trace.h"
+
+#include <chrono>
+#include <vector>
+
+enum { OUT_OK, OUT_TIMEOUT, OUT_CHECKSUM, OUT_WRONG, OUTCOMES };
+
+static const char *const outcome_names[OUTCOMES] = {"ok", "timeout", "checksum",
+                                                    "wrong"};
+
+// one row per impairment, the last one for traces without an annotation
+#define ROW_UNKNOWN TRACE_KINDS
+
+static int classify(const dht_trace_t &trace, uint8_t *data) {
+  switch (dht_decode_frame(trace.widths, data)) {
+  case DHT_DECODE_TIMEOUT:
+    return OUT_TIMEOUT;
+  case DHT_DECODE_CHECKSUM:
+    return OUT_CHECKSUM;
+  }
+  if (trace.has_expect && memcmp(data, trace.expect, 5)) {
+    return OUT_WRONG;
+  }
+  return OUT_OK;
+}
+
+// every DHT11 reading (4-100 %RH, -9.9 to 80.9 C) and every DHT22 reading
+// (0-100.0 %RH, -40.0 to 80.0 C), returns the number misclassified
+static unsigned long check_layouts(void) {
+  unsigned long bad = 0;
+  uint8_t data[5];
+  for (int h = 4; h <= 100; h++) {
+    for (int t = 0; t <= 80; t++) {
+      for (int f = 0; f <= 9; f++) {
+        data[0] = (uint8_t)h;
+        data[1] = (uint8_t)(f % 2);
+        data[2] = (uint8_t)t;
+        data[3] = (uint8_t)(f | ((t < 10 && (h & 1)) ? 0x80 : 0));
+        bad += dht_classify_frame(data) != DHT_FRAME_DHT11;
+      }
+    }
+  }
+  for (int h = 0; h <= 1000; h++) {
+    for (int t = -400; t <= 800; t++) {
+      uint16_t raw = t < 0 ? (uint16_t)(-t | 0x8000) : (uint16_t)t;
+      data[0] = (uint8_t)(h >> 8);
+      data[1] = (uint8_t)h;
+      data[2] = (uint8_t)(raw >> 8);
+      data[3] = (uint8_t)raw;
+      bad += dht_classify_frame(data) != DHT_FRAME_DHT22;
+    }
+  }
+  return bad;
+}
+
+static bool load_file(const char *name, std::vector<dht_trace_t> &traces) {
+  FILE *f = strcmp(name, "-") ? fopen(name, "r") : stdin;
+  if (!f) {
+    perror(name);
+    return false;
+  }
+  char line[1024];
+  dht_trace_t trace;
+  while (fgets(line, sizeof(line), f)) {
+    if (trace_parse(line, trace)) {
+      traces.push_back(trace);
+    }
+  }
+  if (f != stdin) {
+    fclose(f);
+  }
+  return true;
+}
+
+int main(int argc, char **argv) {
+  unsigned long frames = 100000;
+  uint64_t seed = 1;
+  double jitter_us = 3.0, min_secs = 0.5;
+  bool verbose = false;
+  std::vector<const char *> files;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-n") && i + 1 < argc) frames = strtoul(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-s") && i + 1 < argc) seed = strtoull(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-j") && i + 1 < argc) jitter_us = atof(argv[++i]);
+    else if (!strcmp(argv[i], "-t") && i + 1 < argc) min_secs = atof(argv[++i]);
+    else if (!strcmp(argv[i], "-v")) verbose = true;
+    else if (argv[i][0] != '-' || !strcmp(argv[i], "-")) files.push_back(argv[i]);
+    else {
+      fprintf(stderr, "usage: %s [-n frames] [-s seed] [-j jitter_us] [-t seconds] [-v] [file...]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  std::vector<dht_trace_t> traces;
+  if (files.empty()) {
+    trace_rng_t rng(seed);
+    traces.resize(frames);
+    for (unsigned long n = 0; n < frames; n++) {
+      trace_synthesize(rng, (int)(n % TRACE_KINDS), jitter_us, traces[n]);
+    }
+  } else {
+    for (size_t i = 0; i < files.size(); i++) {
+      if (!load_file(files[i], traces)) {
+        return 2;
+      }
+    }
+  }
+  if (traces.empty()) {
+    fprintf(stderr, "%s: no traces\n", argv[0]);
+    return 2;
+  }
+
+  unsigned long misclassified = check_layouts();
+  printf("layouts: %lu readings misclassified\n", misclassified);
+
+  // classification
+  unsigned long counts[TRACE_KINDS + 1][OUTCOMES];
+  memset(counts, 0, sizeof(counts));
+  for (size_t n = 0; n < traces.size(); n++) {
+    uint8_t data[5];
+    int out = classify(traces[n], data);
+    int row = traces[n].kind >= 0 ? traces[n].kind : ROW_UNKNOWN;
+    counts[row][out]++;
+    if (verbose && out != OUT_OK) {
+      printf("trace %zu %s %s:", n, row == ROW_UNKNOWN ? "-" : trace_kind_names[row],
+             outcome_names[out]);
+      for (int i = 0; i < 5; i++) printf(" %02x", data[i]);
+      printf("\n  ");
+      trace_write(stdout, traces[n]);
+    }
+  }
+
+  printf("%-10s %9s", "trace", "count");
+  for (int o = 0; o < OUTCOMES; o++) printf(" %9s", outcome_names[o]);
+  printf("\n");
+  for (int r = 0; r <= ROW_UNKNOWN; r++) {
+    unsigned long total = 0;
+    for (int o = 0; o < OUTCOMES; o++) total += counts[r][o];
+    if (total == 0) continue;
+    printf("%-10s %9lu", r == ROW_UNKNOWN ? "recorded" : trace_kind_names[r], total);
+    for (int o = 0; o < OUTCOMES; o++) printf(" %9lu", counts[r][o]);
+    printf("\n");
+  }
+
+  // throughput, the sink keeps the decode from being optimized away
+  uint32_t sink = 0;
+  uint64_t decoded = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  double secs = 0;
+  do {
+    for (size_t n = 0; n < traces.size(); n++) {
+      uint8_t data[5];
+      sink += dht_decode_frame(traces[n].widths, data) + data[0] + data[4];
+    }
+    decoded += traces.size();
+    secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  } while (secs < min_secs);
+  printf("%llu frames decoded in %.2f s, %.0f frames/s, %.1f ns/frame (sink %u)\n",
+         (unsigned long long)decoded, secs, decoded / secs, secs * 1e9 / decoded,
+         (unsigned)sink);
+
+  unsigned long bad = counts[TRACE_CLEAN][OUT_TIMEOUT] + counts[TRACE_CLEAN][OUT_CHECKSUM] +
+                      counts[TRACE_CLEAN][OUT_WRONG];
+  if (bad) {
+    printf("FAIL: %lu clean traces not decoded to their frame\n", bad);
+  }
+  if (misclassified) {
+    printf("FAIL: %lu readings classified as the wrong layout\n", misclassified);
+  }
+  return (bad || misclassified) ? 1 : 0;
+}
@@ -0,0 +1,225 @@
+// DHT pulse trace synthesis, shared by dht_trace_gen and dht_replay.
+//
+// A synthesized trace is a valid frame (DHT11 or DHT22 layout, correct
+// checksum) sent with the pulse widths of a real sensor, then put through
+// one impairment. The trace format is the one of lib/DHT/DHT_decode.h; the
+// text form adds a trailing comment with the frame that was sent and the
+// impairment, which dht_replay uses as the ground truth:
+//
+//   w0 w1 ... w79 # expect 02 8c 01 15 a4 glitch
+//
+// Widths are in the unit of one of the capture paths of the driver: micros()
+// of the edge interrupt, Timer1 ticks of the input capture (0.5 us at 16 MHz)
+// or loop counts of the blocking read (~0.6 per us on a 16 MHz AVR).
+
+#ifndef DHT_TRACE_H
+#define DHT_TRACE_H
+
+#include <DHT_decode.h>
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// impairments, one per trace
+enum {
+  TRACE_CLEAN,     // nominal widths, per sensor skew only
+  TRACE_JITTER,    // gaussian jitter on every width
+  TRACE_TRUNCATED, // frame cut short, the remaining pulses time out
+  TRACE_GLITCH,    // a spike splits one pulse in three, the rest shifts
+  TRACE_DROPOUT,   // a missed edge merges two pulses, the rest shifts
+  TRACE_KINDS
+};
+
+static const char *const trace_kind_names[TRACE_KINDS] = {
+    "clean", "jitter", "truncated", "glitch", "dropout"};
+
+struct dht_trace_t {
+  uint32_t widths[DHT_FRAME_PULSES];
+  uint8_t expect[5];
+  bool has_expect;
+  int kind; // TRACE_*, -1 when the line has no annotation
+};
+
+struct trace_rng_t {
+  uint64_t s;
+  explicit trace_rng_t(uint64_t seed) : s(seed * 0x9E3779B97F4A7C15ULL + 1) {}
+  uint32_t next() {
+    s ^= s << 13;
+    s ^= s >> 7;
+    s ^= s << 17;
+    return (uint32_t)(s >> 16);
+  }
+  int range(int n) { return (int)(next() % (uint32_t)n); }
+  double uniform(double lo, double hi) {
+    return lo + (hi - lo) * (next() & 0xFFFFFF) / (double)0xFFFFFF;
+  }
+  double gauss() {
+    // Box-Muller, one value per call is enough here
+    double u = uniform(1e-9, 1.0), v = uniform(0.0, 1.0);
+    return sqrt(-2.0 * log(u)) * cos(6.283185307179586 * v);
+  }
+};
+
+// a frame the sensor could send, checksum included
+static inline void trace_random_frame(trace_rng_t &rng, uint8_t *data) {
+  if (rng.range(2)) {
+    // DHT11: integral humidity and temperature, decimal byte 0 on most parts
+    data[0] = (uint8_t)(20 + rng.range(71));
+    data[1] = 0;
+    data[2] = (uint8_t)rng.range(51);
+    data[3] = (uint8_t)rng.range(10);
+  } else {
+    // DHT22: 16-bit tenths, sign bit on the temperature
+    uint16_t h = (uint16_t)rng.range(1001);
+    uint16_t t = (uint16_t)rng.range(801);
+    if (rng.range(4) == 0) {
+      t = (uint16_t)(rng.range(401) | 0x8000);
+    }
+    data[0] = h >> 8;
+    data[1] = h & 0xFF;
+    data[2] = t >> 8;
+    data[3] = t & 0xFF;
+  }
+  data[4] = (uint8_t)(data[0] + data[1] + data[2] + data[3]);
+}
+
+// widths of a frame in microseconds, within the datasheet ranges: low 48-55,
+// high 22-30 for a 0 and 68-75 for a 1, fixed per sensor
+static inline void trace_nominal(trace_rng_t &rng, const uint8_t *data,
+                                 double *us) {
+  double low = rng.uniform(48, 55);
+  double zero = rng.uniform(22, 30);
+  double one = rng.uniform(68, 75);
+  for (int i = 0; i < 40; i++) {
+    bool bit = (data[i / 8] >> (7 - i % 8)) & 1;
+    us[2 * i] = low;
+    us[2 * i + 1] = bit ? one : zero;
+  }
+}
+
+// remove pulse i, shift the rest down and time out the last one
+static inline void trace_drop(double *us, int i) {
+  memmove(&us[i], &us[i + 1], (DHT_FRAME_PULSES - 1 - i) * sizeof(*us));
+  us[DHT_FRAME_PULSES - 1] = 0;
+}
+
+// make room after pulse i, the last pulse falls off the frame
+static inline void trace_insert(double *us, int i) {
+  memmove(&us[i + 1], &us[i], (DHT_FRAME_PULSES - 1 - i) * sizeof(*us));
+}
+
+// one synthesized trace, jitter_us is the standard deviation of the jitter
+static inline void trace_synthesize(trace_rng_t &rng, int kind,
+                                    double jitter_us, dht_trace_t &trace) {
+  double us[DHT_FRAME_PULSES];
+  trace_random_frame(rng, trace.expect);
+  trace.has_expect = true;
+  trace.kind = kind;
+  trace_nominal(rng, trace.expect, us);
+
+  switch (kind) {
+  case TRACE_JITTER:
+    for (int i = 0; i < DHT_FRAME_PULSES; i++) {
+      us[i] += jitter_us * rng.gauss();
+      if (us[i] < 1) {
+        us[i] = 1;
+      }
+    }
+    break;
+  case TRACE_TRUNCATED:
+    for (int i = 1 + rng.range(DHT_FRAME_PULSES - 1); i < DHT_FRAME_PULSES; i++) {
+      us[i] = 0;
+    }
+    break;
+  case TRACE_GLITCH: {
+    // a 1-6 us spike somewhere in pulse i: i, spike, rest of i
+    int i = rng.range(DHT_FRAME_PULSES - 2);
+    double spike = rng.uniform(1, 6);
+    double head = rng.uniform(1, us[i] > spike + 2 ? us[i] - spike - 1 : 1);
+    double tail = us[i] - head - spike;
+    trace_insert(us, i);
+    trace_insert(us, i);
+    us[i] = head;
+    us[i + 1] = spike;
+    us[i + 2] = tail < 1 ? 1 : tail;
+    break;
+  }
+  case TRACE_DROPOUT: {
+    int i = rng.range(DHT_FRAME_PULSES - 1);
+    us[i] += us[i + 1];
+    trace_drop(us, i + 1);
+    break;
+  }
+  }
+
+  // unit of the capture path
+  static const double units_per_us[] = {1.0, 2.0, 0.6};
+  double scale = units_per_us[rng.range(3)];
+  for (int i = 0; i < DHT_FRAME_PULSES; i++) {
+    uint32_t w = (uint32_t)(us[i] * scale + 0.5);
+    // a pulse that was received is never reported as a timeout
+    trace.widths[i] = (us[i] > 0 && w == 0) ? 1 : w;
+  }
+}
+
+static inline void trace_write(FILE *f, const dht_trace_t &trace) {
+  for (int i = 0; i < DHT_FRAME_PULSES; i++) {
+    fprintf(f, i ? " %u" : "%u", (unsigned)trace.widths[i]);
+  }
+  if (trace.has_expect) {
+    fprintf(f, " # expect %02x %02x %02x %02x %02x", trace.expect[0],
+            trace.expect[1], trace.expect[2], trace.expect[3], trace.expect[4]);
+    if (trace.kind >= 0) {
+      fprintf(f, " %s", trace_kind_names[trace.kind]);
+    }
+  }
+  fprintf(f, "\n");
+}
+
+// parse one text line, false for a blank or comment-only line. A recording
+// cut short may have fewer than 80 widths, the missing ones time out.
+static inline bool trace_parse(char *line, dht_trace_t &trace) {
+  memset(&trace, 0, sizeof(trace));
+  trace.kind = -1;
+
+  char *comment = strchr(line, '#');
+  if (comment) {
+    *comment++ = 0;
+  }
+  int n = 0;
+  for (char *p = line, *end; n < DHT_FRAME_PULSES; p = end) {
+    unsigned long w = strtoul(p, &end, 10);
+    if (end == p) {
+      break;
+    }
+    trace.widths[n++] = (uint32_t)w;
+  }
+  if (n == 0) {
+    return false;
+  }
+
+  unsigned b[5];
+  char kind[32];
+  int fields = comment ? sscanf(comment, " expect %x %x %x %x %x %31s", &b[0],
+                                &b[1], &b[2], &b[3], &b[4], kind)
+                       : 0;
+  if (fields >= 5) {
+    trace.has_expect = true;
+    for (int i = 0; i < 5; i++) {
+      trace.expect[i] = (uint8_t)b[i];
+    }
+  }
+  if (fields == 6) {
+    for (int k = 0; k < TRACE_KINDS; k++) {
+      if (!strcmp(kind, trace_kind_names[k])) {
+        trace.kind = k;
+      }
+    }
+  }
+  return true;
+}
+
+#endif
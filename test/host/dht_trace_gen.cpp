@@ -0,0 +1,47 @@
+// Trace corpus generator for dht_replay.
+//
+// Writes synthesized DHT traces in the text format of lib/DHT/DHT_decode.h,
+// each annotated with the frame that was sent and its impairment (see
+// dht_trace.h). The same seed always gives the same corpus.
+//
+//   dht_trace_gen [-n frames] [-s seed] [-j jitter_us] [-k kind] > traces.txt
+//
+// kind is one of clean, jitter, truncated, glitch or dropout; without -k the
+// impairments are mixed evenly.
+
+#include "dht_trace.h"
+
+int main(int argc, char **argv) {
+  unsigned long frames = 5000;
+  uint64_t seed = 1;
+  double jitter_us = 3.0;
+  int kind = -1;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-n") && i + 1 < argc) frames = strtoul(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-s") && i + 1 < argc) seed = strtoull(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-j") && i + 1 < argc) jitter_us = atof(argv[++i]);
+    else if (!strcmp(argv[i], "-k") && i + 1 < argc) {
+      const char *name = argv[++i];
+      for (int k = 0; k < TRACE_KINDS; k++) {
+        if (!strcmp(name, trace_kind_names[k])) kind = k;
+      }
+      if (kind < 0) {
+        fprintf(stderr, "%s: unknown kind %s\n", argv[0], name);
+        return 2;
+      }
+    } else {
+      fprintf(stderr, "usage: %s [-n frames] [-s seed] [-j jitter_us] [-k kind]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  trace_rng_t rng(seed);
+  printf("# dht_trace_gen -n %lu -s %llu -j %g\n", frames, (unsigned long long)seed, jitter_us);
+  for (unsigned long n = 0; n < frames; n++) {
+    dht_trace_t trace;
+    trace_synthesize(rng, kind >= 0 ? kind : (int)(n % TRACE_KINDS), jitter_us, trace);
+    trace_write(stdout, trace);
+  }
+  return 0;
+}
@@ -0,0 +1,981 @@
+// Differential conformance harness for lib/Fuzzy.
+//
+// Random models and inputs are evaluated by the reference path, a frozen
+// copy of the baseline engine (fuzzy_ref.cpp), and by every path of the
+// current engine in the table below, all built from the same model description and alive at the same
+// time. The outputs are compared in absolute value and in ULP, and the
+// fired-rule sets must match exactly. A failing case is shrunk to a minimal
+// model and printed with the seed that replays it.
+//
+//   fuzzy_diff [-n cases] [-j jobs] [-s seed] [-u max_ulp] [-c case] [-b models] [-v]
+//
+// A new evaluation path is one more entry in diff_paths[].
+
+#include <Fuzzy.h>
+#include <FuzzyInput.h>
+#include <FuzzyOutput.h>
+#include <FuzzyRule.h>
+#include <FuzzyRuleAntecedent.h>
+#include <FuzzyRuleConsequent.h>
+#include <FuzzySet.h>
+
+#include "fuzzy_model.h"
+
+#include <atomic>
+#include <chrono>
+#include <math.h>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// random generation
+
+struct rng_t {
+  uint64_t s;
+  explicit rng_t(uint64_t seed) : s(seed * 0x9E3779B97F4A7C15ULL + 1) {}
+  uint32_t next() {
+    s ^= s << 13;
+    s ^= s >> 7;
+    s ^= s << 17;
+    return (uint32_t)(s >> 16);
+  }
+  int range(int n) { return (int)(next() % (uint32_t)n); }
+  float uniform(float lo, float hi) {
+    return lo + (hi - lo) * (next() & 0xFFFFFF) / (float)0xFFFFFF;
+  }
+};
+
+// breakpoints snap to a coarse grid half the time so that sets share points
+// and the exact == comparisons in truncate/checkPoint are exercised
+static float random_point(rng_t &rng) {
+  if (rng.range(2)) {
+    return (float)(rng.range(21) * 5);
+  }
+  return rng.uniform(0, 100);
+}
+
+static set_spec_t random_set(rng_t &rng) {
+  float p[4];
+  for (int i = 0; i < 4; i++) {
+    p[i] = random_point(rng);
+  }
+  // sorted, with the usual degenerate shapes on purpose
+  for (int i = 1; i < 4; i++) {
+    for (int j = i; j > 0 && p[j] < p[j - 1]; j--) {
+      float t = p[j];
+      p[j] = p[j - 1];
+      p[j - 1] = t;
+    }
+  }
+  switch (rng.range(6)) {
+  case 0: // triangle
+    p[2] = p[1];
+    break;
+  case 1: // left shoulder
+    p[1] = p[0];
+    break;
+  case 2: // right shoulder
+    p[3] = p[2];
+    break;
+  default:
+    break;
+  }
+  set_spec_t s = {p[0], p[1], p[2], p[3]};
+  return s;
+}
+
+static int random_set_ref(rng_t &rng, const model_spec_t &m) {
+  int i = rng.range(m.input_count);
+  return i * MAX_SETS + rng.range(m.inputs[i].set_count);
+}
+
+static void random_model(rng_t &rng, model_spec_t &m) {
+  memset(&m, 0, sizeof(m));
+  m.input_count = 1 + rng.range(MAX_IO);
+  m.output_count = 1 + rng.range(2);
+  for (int i = 0; i < m.input_count; i++) {
+    m.inputs[i].set_count = 1 + rng.range(MAX_SETS);
+    for (int j = 0; j < m.inputs[i].set_count; j++) {
+      m.inputs[i].sets[j] = random_set(rng);
+    }
+  }
+  for (int i = 0; i < m.output_count; i++) {
+    m.outputs[i].set_count = 1 + rng.range(MAX_SETS);
+    for (int j = 0; j < m.outputs[i].set_count; j++) {
+      m.outputs[i].sets[j] = random_set(rng);
+    }
+  }
+
+  m.rule_count = 1 + rng.range(MAX_RULES);
+  for (int r = 0; r < m.rule_count; r++) {
+    rule_spec_t &rule = m.rules[r];
+    // root plus up to two child nodes
+    rule.node_count = 1 + rng.range(3);
+    for (int n = rule.node_count - 1; n >= 0; n--) {
+      node_spec_t &node = rule.nodes[n];
+      node.op = (n == 0 && rule.node_count == 1) ? rng.range(3) : 1 + rng.range(2);
+      node.node[0] = node.node[1] = -1;
+      node.set[0] = random_set_ref(rng, m);
+      node.set[1] = random_set_ref(rng, m);
+    }
+    // the root takes the children as operands
+    if (rule.node_count > 1) {
+      rule.nodes[0].node[0] = 1;
+    }
+    if (rule.node_count > 2) {
+      rule.nodes[0].node[1] = 2;
+    }
+    rule.out_count = 1 + rng.range(MAX_CONSEQUENTS);
+    for (int k = 0; k < rule.out_count; k++) {
+      int o = rng.range(m.output_count);
+      rule.out[k] = o * MAX_SETS + rng.range(m.outputs[o].set_count);
+    }
+  }
+}
+
+static void random_inputs(rng_t &rng, const model_spec_t &m, float *in) {
+  for (int i = 0; i < m.input_count; i++) {
+    // on a breakpoint a quarter of the time
+    if (rng.range(4) == 0) {
+      const set_spec_t &s = m.inputs[i].sets[rng.range(m.inputs[i].set_count)];
+      const float p[4] = {s.a, s.b, s.c, s.d};
+      in[i] = p[rng.range(4)];
+    } else {
+      in[i] = rng.uniform(-5, 105);
+    }
+  }
+}
+
+// ---------------------------------------------------------------------------
+// building an engine from the description
+
+struct engine_t {
+  Fuzzy *fuzzy;
+  void *buffer;
+  ref_engine_t *ref; // the reference path only
+  std::vector<FuzzySet *> sets;
+  std::vector<FuzzyInput *> inputs;
+  std::vector<FuzzyOutput *> outputs;
+  std::vector<FuzzyRule *> rules;
+  std::vector<FuzzyRuleAntecedent *> antecedents;
+  std::vector<FuzzyRuleConsequent *> consequents;
+};
+
+static void model_dimensions(const model_spec_t &m, fuzzyModelSize *size) {
+  memset(size, 0, sizeof(*size));
+  size->inputs = m.input_count;
+  size->outputs = m.output_count;
+  size->rules = m.rule_count;
+  int max_out_sets = 0;
+  for (int i = 0; i < m.input_count; i++) {
+    size->sets += m.inputs[i].set_count;
+  }
+  for (int i = 0; i < m.output_count; i++) {
+    size->sets += m.outputs[i].set_count;
+    if (m.outputs[i].set_count > max_out_sets) {
+      max_out_sets = m.outputs[i].set_count;
+    }
+  }
+  for (int r = 0; r < m.rule_count; r++) {
+    size->antecedents += m.rules[r].node_count;
+    size->consequentSets += m.rules[r].out_count;
+  }
+  size->maxPoints = 4 * max_out_sets + 1;
+}
+
+static FuzzyRuleAntecedent *build_node(engine_t &e, const rule_spec_t &rule,
+                                       int n, FuzzySet **in_sets) {
+  const node_spec_t &node = rule.nodes[n];
+  FuzzyRuleAntecedent *ante = new FuzzyRuleAntecedent();
+  e.antecedents.push_back(ante);
+
+  FuzzySet *s0 = in_sets[node.set[0]], *s1 = in_sets[node.set[1]];
+  if (node.op == OP_SINGLE) {
+    ante->joinSingle(s0);
+    return ante;
+  }
+
+  FuzzyRuleAntecedent *a0 =
+      (node.node[0] >= 0) ? build_node(e, rule, node.node[0], in_sets) : NULL;
+  FuzzyRuleAntecedent *a1 =
+      (node.node[1] >= 0) ? build_node(e, rule, node.node[1], in_sets) : NULL;
+  bool is_and = (node.op == OP_AND);
+  if (a0 && a1) {
+    is_and ? ante->joinWithAND(a0, a1) : ante->joinWithOR(a0, a1);
+  } else if (a0) {
+    is_and ? ante->joinWithAND(a0, s1) : ante->joinWithOR(a0, s1);
+  } else if (a1) {
+    is_and ? ante->joinWithAND(s0, a1) : ante->joinWithOR(s0, a1);
+  } else {
+    is_and ? ante->joinWithAND(s0, s1) : ante->joinWithOR(s0, s1);
+  }
+  return ante;
+}
+
+static bool build_engine(engine_t &e, const model_spec_t &m, bool arena) {
+  fuzzyArena *a = NULL;
+  e.buffer = NULL;
+  e.ref = NULL;
+  if (arena) {
+    fuzzyModelSize size;
+    model_dimensions(m, &size);
+    fuzzyMemRequirements req = Fuzzy::sizeOf(&size);
+    e.buffer = malloc(req.arenaBytes);
+    e.fuzzy = new Fuzzy(e.buffer, req.arenaBytes, &size);
+    a = e.fuzzy->getArena();
+  } else {
+    e.fuzzy = new Fuzzy();
+  }
+
+  FuzzySet *in_sets[MAX_IO * MAX_SETS], *out_sets[MAX_IO * MAX_SETS];
+  for (int i = 0; i < m.input_count; i++) {
+    FuzzyInput *input = new FuzzyInput(i, a);
+    e.inputs.push_back(input);
+    for (int j = 0; j < m.inputs[i].set_count; j++) {
+      const set_spec_t &s = m.inputs[i].sets[j];
+      FuzzySet *set = new FuzzySet(s.a, s.b, s.c, s.d);
+      e.sets.push_back(set);
+      in_sets[i * MAX_SETS + j] = set;
+      input->addFuzzySet(set);
+    }
+    e.fuzzy->addFuzzyInput(input);
+  }
+  for (int i = 0; i < m.output_count; i++) {
+    FuzzyOutput *output = new FuzzyOutput(i, a);
+    e.outputs.push_back(output);
+    for (int j = 0; j < m.outputs[i].set_count; j++) {
+      const set_spec_t &s = m.outputs[i].sets[j];
+      FuzzySet *set = new FuzzySet(s.a, s.b, s.c, s.d);
+      e.sets.push_back(set);
+      out_sets[i * MAX_SETS + j] = set;
+      output->addFuzzySet(set);
+    }
+    e.fuzzy->addFuzzyOutput(output);
+  }
+  for (int r = 0; r < m.rule_count; r++) {
+    const rule_spec_t &rule = m.rules[r];
+    FuzzyRuleConsequent *then = new FuzzyRuleConsequent(a);
+    e.consequents.push_back(then);
+    for (int k = 0; k < rule.out_count; k++) {
+      then->addOutput(out_sets[rule.out[k]]);
+    }
+    FuzzyRule *fr = new FuzzyRule(r, build_node(e, rule, 0, in_sets), then);
+    e.rules.push_back(fr);
+    e.fuzzy->addFuzzyRule(fr);
+  }
+  return e.fuzzy->isValid();
+}
+
+static void free_engine(engine_t &e) {
+  // the Fuzzy first, it hands the composition points back to its arena
+  delete e.fuzzy;
+  for (size_t i = 0; i < e.rules.size(); i++) delete e.rules[i];
+  for (size_t i = 0; i < e.antecedents.size(); i++) delete e.antecedents[i];
+  for (size_t i = 0; i < e.consequents.size(); i++) delete e.consequents[i];
+  for (size_t i = 0; i < e.inputs.size(); i++) delete e.inputs[i];
+  for (size_t i = 0; i < e.outputs.size(); i++) delete e.outputs[i];
+  for (size_t i = 0; i < e.sets.size(); i++) delete e.sets[i];
+  free(e.buffer);
+  ref_free(e.ref);
+}
+
+static bool fuzzify(engine_t &e, const model_spec_t &m, const float *in,
+                    eval_result_t &res) {
+  for (int i = 0; i < m.input_count; i++) {
+    e.fuzzy->setInput(i, in[i]);
+  }
+  res.ok = e.fuzzy->fuzzify();
+  res.fired_count = e.fuzzy->getFiredRules(res.fired, MAX_RULES);
+  return res.ok;
+}
+
+// ---------------------------------------------------------------------------
+// evaluation paths, [0] is the reference
+
+// the baseline engine of fuzzy_ref.cpp
+static bool build_reference(engine_t &e, const model_spec_t &m) {
+  e.fuzzy = NULL;
+  e.buffer = NULL;
+  e.ref = ref_build(m);
+  return true;
+}
+
+static void eval_reference(engine_t &e, const model_spec_t &m, const float *in,
+                           eval_result_t &res) {
+  ref_eval(e.ref, m, in, res);
+}
+
+// heap Fuzzy, outputs read once in order
+static bool build_heap(engine_t &e, const model_spec_t &m) {
+  return build_engine(e, m, false);
+}
+
+static void eval_in_order(engine_t &e, const model_spec_t &m, const float *in,
+                          eval_result_t &res) {
+  if (fuzzify(e, m, in, res)) {
+    for (int o = 0; o < m.output_count; o++) {
+      res.out[o] = e.fuzzy->defuzzify(o);
+    }
+  }
+}
+
+// caller buffer sized by Fuzzy::sizeOf, no malloc in the engine
+static bool build_arena(engine_t &e, const model_spec_t &m) {
+  return build_engine(e, m, true);
+}
+
+// outputs read backwards, twice: the deferred truncation and the crisp
+// cache must give the same value whatever the order
+static void eval_reread(engine_t &e, const model_spec_t &m, const float *in,
+                        eval_result_t &res) {
+  if (!fuzzify(e, m, in, res)) {
+    return;
+  }
+  for (int o = m.output_count - 1; o >= 0; o--) {
+    res.out[o] = e.fuzzy->defuzzify(o);
+  }
+  for (int o = m.output_count - 1; o >= 0; o--) {
+    float again = e.fuzzy->defuzzify(o);
+    if (memcmp(&again, &res.out[o], sizeof(float)) != 0) {
+      res.ok = false;
+    }
+  }
+}
+
+struct diff_path_t {
+  const char *name;
+  bool (*build)(engine_t &e, const model_spec_t &m);
+  void (*eval)(engine_t &e, const model_spec_t &m, const float *in,
+               eval_result_t &res);
+};
+
+static const diff_path_t diff_paths[] = {
+    {"reference", build_reference, eval_reference},
+    {"heap", build_heap, eval_in_order},
+    {"arena", build_arena, eval_in_order},
+    {"reread", build_heap, eval_reread},
+};
+#define PATH_COUNT (int)(sizeof(diff_paths) / sizeof(diff_paths[0]))
+
+// ---------------------------------------------------------------------------
+// comparison
+
+static uint32_t ulp_distance(float x, float y) {
+  if (isnan(x) || isnan(y)) {
+    return (isnan(x) && isnan(y)) ? 0 : 0xFFFFFFFF;
+  }
+  int32_t ix, iy;
+  memcpy(&ix, &x, 4);
+  memcpy(&iy, &y, 4);
+  // ordered integer image of the float line
+  if (ix < 0) ix = (int32_t)0x80000000 - ix;
+  if (iy < 0) iy = (int32_t)0x80000000 - iy;
+  int64_t d = (int64_t)ix - (int64_t)iy;
+  if (d < 0) d = -d;
+  return d > 0xFFFFFFFFLL ? 0xFFFFFFFF : (uint32_t)d;
+}
+
+struct path_stats_t {
+  uint64_t evals, outputs, failures, fired_mismatch, invalid;
+  double max_abs, sum_abs;
+  uint32_t max_ulp;
+};
+
+static uint32_t max_ulp_allowed = 0;
+
+// difference of one path against the reference, true when it fails
+static bool compare(const model_spec_t &m, const eval_result_t &ref,
+                    const eval_result_t &res, path_stats_t *st) {
+  bool fail = false;
+  if (st) st->evals++;
+  if (ref.ok != res.ok) {
+    if (st) st->invalid++;
+    return true;
+  }
+  if (!ref.ok) {
+    return false;
+  }
+  if (ref.fired_count != res.fired_count ||
+      memcmp(ref.fired, res.fired, sizeof(int) * (ref.fired_count < MAX_RULES ? ref.fired_count : MAX_RULES)) != 0) {
+    if (st) st->fired_mismatch++;
+    fail = true;
+  }
+  for (int o = 0; o < m.output_count; o++) {
+    uint32_t ulp = ulp_distance(ref.out[o], res.out[o]);
+    double diff = fabs((double)ref.out[o] - (double)res.out[o]);
+    if (isnan(diff)) diff = (ulp == 0) ? 0 : INFINITY;
+    if (st) {
+      st->outputs++;
+      st->sum_abs += diff;
+      if (diff > st->max_abs) st->max_abs = diff;
+      if (ulp > st->max_ulp) st->max_ulp = ulp;
+    }
+    if (ulp > max_ulp_allowed) {
+      fail = true;
+    }
+  }
+  return fail;
+}
+
+// every path on count inputs in a row, on the same engines so that state
+// left by one evaluation shows up in the next. stats may be NULL. returns
+// the failing paths, first_fail is the first failing input.
+static uint32_t run_case(const model_spec_t &m, const float (*in)[MAX_IO],
+                         int count, path_stats_t *stats, int *first_fail) {
+  engine_t engines[PATH_COUNT];
+  eval_result_t res[PATH_COUNT];
+  bool built[PATH_COUNT];
+  uint32_t failed = 0;
+
+  // all paths alive together, an engine must not disturb another one
+  for (int p = 0; p < PATH_COUNT; p++) {
+    built[p] = diff_paths[p].build(engines[p], m);
+  }
+  for (int k = 0; k < count; k++) {
+    uint32_t failed_here = 0;
+    for (int p = 0; p < PATH_COUNT; p++) {
+      memset(&res[p], 0, sizeof(res[p]));
+      if (built[p]) {
+        diff_paths[p].eval(engines[p], m, in[k], res[p]);
+      }
+    }
+    for (int p = 1; p < PATH_COUNT; p++) {
+      if (built[0] != built[p] ||
+          compare(m, res[0], res[p], stats ? &stats[p] : NULL)) {
+        failed_here |= 1u << p;
+        if (stats) stats[p].failures++;
+      }
+    }
+    if (failed_here && !failed && first_fail) {
+      *first_fail = k;
+    }
+    failed |= failed_here;
+  }
+  for (int p = 0; p < PATH_COUNT; p++) {
+    free_engine(engines[p]);
+  }
+  return failed;
+}
+
+// ---------------------------------------------------------------------------
+// shrinking
+
+// drop every rule that points at a removed set
+static void remove_input_set(model_spec_t &m, int i, int j) {
+  io_spec_t &io = m.inputs[i];
+  for (int k = j; k < io.set_count - 1; k++) io.sets[k] = io.sets[k + 1];
+  io.set_count--;
+  int ref = i * MAX_SETS + j;
+  int r = 0;
+  for (int k = 0; k < m.rule_count; k++) {
+    rule_spec_t rule = m.rules[k];
+    bool uses = false;
+    for (int n = 0; n < rule.node_count; n++) {
+      node_spec_t &node = rule.nodes[n];
+      for (int s = 0; s < 2; s++) {
+        bool used = (node.op != OP_SINGLE || s == 0) && node.node[s] < 0;
+        if (node.set[s] == ref && used) uses = true;
+        if (node.set[s] > ref && node.set[s] / MAX_SETS == i) node.set[s]--;
+        if (node.set[s] == ref) node.set[s] = i * MAX_SETS; // unused operand
+      }
+    }
+    if (!uses) m.rules[r++] = rule;
+  }
+  m.rule_count = r;
+}
+
+static void remove_output_set(model_spec_t &m, int i, int j) {
+  io_spec_t &io = m.outputs[i];
+  for (int k = j; k < io.set_count - 1; k++) io.sets[k] = io.sets[k + 1];
+  io.set_count--;
+  int ref = i * MAX_SETS + j;
+  int r = 0;
+  for (int k = 0; k < m.rule_count; k++) {
+    rule_spec_t rule = m.rules[k];
+    int c = 0;
+    for (int o = 0; o < rule.out_count; o++) {
+      int out = rule.out[o];
+      if (out == ref) continue;
+      if (out > ref && out / MAX_SETS == i) out--;
+      rule.out[c++] = out;
+    }
+    rule.out_count = c;
+    if (c > 0) m.rules[r++] = rule;
+  }
+  m.rule_count = r;
+}
+
+static bool model_usable(const model_spec_t &m) {
+  if (m.rule_count == 0) return false;
+  for (int i = 0; i < m.input_count; i++)
+    if (m.inputs[i].set_count == 0) return false;
+  for (int i = 0; i < m.output_count; i++)
+    if (m.outputs[i].set_count == 0) return false;
+  return true;
+}
+
+static bool still_fails(const model_spec_t &m, const float *in) {
+  return model_usable(m) &&
+         run_case(m, (const float(*)[MAX_IO])in, 1, NULL, NULL) != 0;
+}
+
+// greedy: keep any single simplification that still fails, until none does
+static void shrink(model_spec_t &m, float *in) {
+  bool progress = true;
+  while (progress) {
+    progress = false;
+    model_spec_t t;
+
+    for (int r = 0; r < m.rule_count && m.rule_count > 1; r++) {
+      t = m;
+      for (int k = r; k < t.rule_count - 1; k++) t.rules[k] = t.rules[k + 1];
+      t.rule_count--;
+      if (still_fails(t, in)) { m = t; progress = true; r--; }
+    }
+    for (int r = 0; r < m.rule_count; r++) {
+      for (int s = 0; s < 2 && m.rules[r].node_count > 1; s++) {
+        // root replaced by one of its operands
+        t = m;
+        rule_spec_t &rule = t.rules[r];
+        int child = rule.nodes[0].node[s];
+        if (child >= 0) {
+          rule.nodes[0] = rule.nodes[child];
+          rule.node_count = 1;
+          rule.nodes[0].node[0] = rule.nodes[0].node[1] = -1;
+        } else {
+          rule.nodes[0].op = OP_SINGLE;
+          rule.nodes[0].set[0] = rule.nodes[0].set[s];
+          rule.nodes[0].node[0] = rule.nodes[0].node[1] = -1;
+          rule.node_count = 1;
+        }
+        if (still_fails(t, in)) { m = t; progress = true; }
+      }
+      if (m.rules[r].node_count == 1 && m.rules[r].nodes[0].op != OP_SINGLE) {
+        for (int s = 0; s < 2; s++) {
+          t = m;
+          t.rules[r].nodes[0].op = OP_SINGLE;
+          t.rules[r].nodes[0].set[0] = t.rules[r].nodes[0].set[s];
+          if (still_fails(t, in)) { m = t; progress = true; break; }
+        }
+      }
+      while (m.rules[r].out_count > 1) {
+        t = m;
+        t.rules[r].out_count--;
+        if (!still_fails(t, in)) break;
+        m = t;
+        progress = true;
+      }
+    }
+    for (int i = 0; i < m.input_count; i++) {
+      for (int j = 0; j < m.inputs[i].set_count && m.inputs[i].set_count > 1; j++) {
+        t = m;
+        remove_input_set(t, i, j);
+        if (still_fails(t, in)) { m = t; progress = true; j--; }
+      }
+    }
+    for (int i = 0; i < m.output_count; i++) {
+      for (int j = 0; j < m.outputs[i].set_count && m.outputs[i].set_count > 1; j++) {
+        t = m;
+        remove_output_set(t, i, j);
+        if (still_fails(t, in)) { m = t; progress = true; j--; }
+      }
+    }
+    // round breakpoints and inputs to whole numbers
+    for (int i = 0; i < m.input_count; i++) {
+      float old = in[i];
+      if (old != roundf(old)) {
+        in[i] = roundf(old);
+        if (still_fails(m, in)) progress = true; else in[i] = old;
+      }
+    }
+    for (int side = 0; side < 2; side++) {
+      int count = side ? m.output_count : m.input_count;
+      for (int i = 0; i < count; i++) {
+        io_spec_t &io = side ? m.outputs[i] : m.inputs[i];
+        for (int j = 0; j < io.set_count; j++) {
+          float *p = &io.sets[j].a;
+          for (int k = 0; k < 4; k++) {
+            float old = p[k];
+            if (old == roundf(old)) continue;
+            t = m;
+            io_spec_t &tio = side ? t.outputs[i] : t.inputs[i];
+            float *tp = &tio.sets[j].a;
+            tp[k] = roundf(old);
+            if ((k == 0 || tp[k - 1] <= tp[k]) && (k == 3 || tp[k] <= tp[k + 1]) &&
+                still_fails(t, in)) {
+              m = t;
+              progress = true;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+static void print_model(const model_spec_t &m, const float *in) {
+  for (int i = 0; i < m.input_count; i++) {
+    printf("  input %d = %.9g\n", i, in[i]);
+    for (int j = 0; j < m.inputs[i].set_count; j++) {
+      const set_spec_t &s = m.inputs[i].sets[j];
+      printf("    set %d: (%.9g, %.9g, %.9g, %.9g)\n", i * MAX_SETS + j, s.a, s.b, s.c, s.d);
+    }
+  }
+  for (int i = 0; i < m.output_count; i++) {
+    printf("  output %d\n", i);
+    for (int j = 0; j < m.outputs[i].set_count; j++) {
+      const set_spec_t &s = m.outputs[i].sets[j];
+      printf("    set %d: (%.9g, %.9g, %.9g, %.9g)\n", i * MAX_SETS + j, s.a, s.b, s.c, s.d);
+    }
+  }
+  static const char *ops[] = {"", "AND", "OR"};
+  for (int r = 0; r < m.rule_count; r++) {
+    const rule_spec_t &rule = m.rules[r];
+    printf("  rule %d:", r);
+    for (int n = 0; n < rule.node_count; n++) {
+      const node_spec_t &node = rule.nodes[n];
+      if (node.op == OP_SINGLE) {
+        printf(" [n%d = s%d]", n, node.set[0]);
+        continue;
+      }
+      printf(" [n%d = ", n);
+      node.node[0] >= 0 ? printf("n%d", node.node[0]) : printf("s%d", node.set[0]);
+      printf(" %s ", ops[node.op]);
+      node.node[1] >= 0 ? printf("n%d", node.node[1]) : printf("s%d", node.set[1]);
+      printf("]");
+    }
+    printf(" ->");
+    for (int k = 0; k < rule.out_count; k++) printf(" s%d", rule.out[k]);
+    printf("\n");
+  }
+}
+
+static void report_failure(uint64_t seed, uint64_t index, model_spec_t m,
+                           float *in) {
+  uint32_t failed = run_case(m, (const float(*)[MAX_IO])in, 1, NULL, NULL);
+  if (!failed) {
+    // only fails after the earlier inputs of the case, replay it with -c
+    printf("FAIL case %llu (seed %llu): depends on the previous evaluations\n",
+           (unsigned long long)index, (unsigned long long)seed);
+    print_model(m, in);
+    return;
+  }
+  shrink(m, in);
+  printf("FAIL case %llu (seed %llu):", (unsigned long long)index,
+         (unsigned long long)seed);
+  for (int p = 1; p < PATH_COUNT; p++) {
+    if (failed & (1u << p)) printf(" %s", diff_paths[p].name);
+  }
+  printf("\n");
+  print_model(m, in);
+
+  eval_result_t res;
+  for (int p = 0; p < PATH_COUNT; p++) {
+    engine_t e;
+    memset(&res, 0, sizeof(res));
+    if (diff_paths[p].build(e, m)) {
+      diff_paths[p].eval(e, m, in, res);
+    }
+    free_engine(e);
+    printf("  %-10s ok %d fired", diff_paths[p].name, res.ok);
+    for (int k = 0; k < res.fired_count && k < MAX_RULES; k++) printf(" %d", res.fired[k]);
+    printf(" out");
+    for (int o = 0; o < m.output_count; o++) printf(" %.9g", res.out[o]);
+    printf("\n");
+  }
+}
+
+// ---------------------------------------------------------------------------
+// worst-case bound: the operations counted by the engine (FUZZY_OP_COUNT)
+// during one fuzzify() and the defuzzify() of every output must stay within
+// Fuzzy::getWorstCase(), on inputs searched to make them as large as possible
+
+struct op_field_t {
+  const char *name;
+  size_t offset;
+  bool is_max; // a maximum over the evaluation, not a sum
+};
+
+static const op_field_t op_fields[] = {
+    {"membership", offsetof(fuzzyWorstCase, membershipEvals), false},
+    {"rule nodes", offsetof(fuzzyWorstCase, ruleNodeEvals), false},
+    {"consequents", offsetof(fuzzyWorstCase, consequentUpdates), false},
+    {"set resets", offsetof(fuzzyWorstCase, setResets), false},
+    {"max points", offsetof(fuzzyWorstCase, maxPoints), true},
+    {"point checks", offsetof(fuzzyWorstCase, pointChecks), false},
+    {"isect tests", offsetof(fuzzyWorstCase, intersectionTests), false},
+    {"intersections", offsetof(fuzzyWorstCase, intersections), false},
+    {"centroid segs", offsetof(fuzzyWorstCase, centroidSegments), false},
+};
+#define OP_FIELD_COUNT (int)(sizeof(op_fields) / sizeof(op_fields[0]))
+
+static uint32_t op_field(const fuzzyWorstCase &w, int f) {
+  return *(const uint32_t *)((const char *)&w + op_fields[f].offset);
+}
+
+struct bound_stats_t {
+  uint64_t models, evals, violations;
+  uint32_t max_counted[OP_FIELD_COUNT];
+  double max_ratio[OP_FIELD_COUNT]; // counted / bound, per field
+  double max_cycle_ratio;
+};
+
+// every output set used by a rule, all sets present and inputs that land
+// inside several sets at once: the most truncated shapes, points and
+// intersections the dimensions allow
+static void dense_model(rng_t &rng, model_spec_t &m) {
+  random_model(rng, m);
+  for (int side = 0; side < 2; side++) {
+    int count = side ? m.output_count : m.input_count;
+    for (int i = 0; i < count; i++) {
+      io_spec_t &io = side ? m.outputs[i] : m.inputs[i];
+      io.set_count = MAX_SETS;
+      for (int j = 0; j < MAX_SETS; j++) {
+        set_spec_t s = random_set(rng);
+        if (!side) {
+          // wide, every input falls inside most of the sets
+          s.a = -10 + s.a * 0.3f;
+          s.d = 110 - (100 - s.d) * 0.3f;
+        }
+        io.sets[j] = s;
+      }
+    }
+  }
+  m.rule_count = MAX_RULES;
+  for (int r = 0; r < m.rule_count; r++) {
+    rule_spec_t &rule = m.rules[r];
+    rule.node_count = 1 + rng.range(3);
+    for (int n = 0; n < rule.node_count; n++) {
+      node_spec_t &node = rule.nodes[n];
+      node.op = (rule.node_count == 1) ? rng.range(3) : 1 + rng.range(2);
+      node.node[0] = node.node[1] = -1;
+      node.set[0] = random_set_ref(rng, m);
+      node.set[1] = random_set_ref(rng, m);
+    }
+    if (rule.node_count > 1) rule.nodes[0].node[0] = 1;
+    if (rule.node_count > 2) rule.nodes[0].node[1] = 2;
+    // the output sets in turn, so that each one is truncated
+    int o = r % (m.output_count * MAX_SETS);
+    rule.out_count = 1 + rng.range(MAX_CONSEQUENTS);
+    rule.out[0] = (o / MAX_SETS) * MAX_SETS + o % MAX_SETS;
+    for (int k = 1; k < rule.out_count; k++) {
+      int out = rng.range(m.output_count);
+      rule.out[k] = out * MAX_SETS + rng.range(MAX_SETS);
+    }
+  }
+}
+
+static void count_ops(engine_t &e, const model_spec_t &m, const float *in,
+                      fuzzyWorstCase *ops) {
+  eval_result_t res;
+  fuzzyOpCountReset();
+  eval_in_order(e, m, in, res);
+  *ops = fuzzyOpCounts;
+}
+
+// candidate inputs: breakpoints, next to them and halfway between them
+static int input_candidates(const model_spec_t &m, int i, float *c) {
+  float p[MAX_SETS * 4];
+  int n = 0, k = 0;
+  for (int j = 0; j < m.inputs[i].set_count; j++) {
+    const set_spec_t &s = m.inputs[i].sets[j];
+    p[n++] = s.a; p[n++] = s.b; p[n++] = s.c; p[n++] = s.d;
+  }
+  for (int a = 0; a < n; a++) {
+    c[k++] = p[a];
+    c[k++] = p[a] - 0.25f;
+    c[k++] = p[a] + 0.25f;
+    for (int b = a + 1; b < n; b++) {
+      c[k++] = (p[a] + p[b]) * 0.5f;
+    }
+  }
+  return k;
+}
+
+// inputs tried per model by the hill climb
+#define BOUND_STEPS 200
+
+// hill climb on the estimated cycles, one input changed per step
+static void check_bound_model(const model_spec_t &m, rng_t &rng, int steps,
+                              bound_stats_t &st) {
+  engine_t e;
+  if (!build_engine(e, m, false)) {
+    free_engine(e);
+    return;
+  }
+  fuzzyWorstCase bound;
+  e.fuzzy->getWorstCase(&bound);
+  uint32_t bound_cycles = Fuzzy::worstCaseCycles(&bound);
+
+  static float cand[MAX_IO][MAX_SETS * 4 * (MAX_SETS * 4 + 5) / 2 + 1];
+  int cand_count[MAX_IO];
+  float in[MAX_IO], best_in[MAX_IO];
+  for (int i = 0; i < m.input_count; i++) {
+    cand_count[i] = input_candidates(m, i, cand[i]);
+    in[i] = best_in[i] = cand[i][rng.range(cand_count[i])];
+  }
+
+  uint32_t best_cycles = 0;
+  for (int step = 0; step < steps; step++) {
+    fuzzyWorstCase ops;
+    count_ops(e, m, in, &ops);
+    st.evals++;
+    bool over = false;
+    for (int f = 0; f < OP_FIELD_COUNT; f++) {
+      uint32_t c = op_field(ops, f), b = op_field(bound, f);
+      if (c > b) over = true;
+      if (c > st.max_counted[f]) st.max_counted[f] = c;
+      double ratio = b ? (double)c / b : (c ? INFINITY : 0);
+      if (ratio > st.max_ratio[f]) st.max_ratio[f] = ratio;
+    }
+    uint32_t cycles = Fuzzy::worstCaseCycles(&ops);
+    double cycle_ratio = bound_cycles ? (double)cycles / bound_cycles : 0;
+    if (cycle_ratio > st.max_cycle_ratio) st.max_cycle_ratio = cycle_ratio;
+    if (over && st.violations++ < 3) {
+      printf("FAIL bound: counted operations over Fuzzy::getWorstCase\n");
+      for (int f = 0; f < OP_FIELD_COUNT; f++) {
+        printf("  %-14s %8u / %8u\n", op_fields[f].name, op_field(ops, f), op_field(bound, f));
+      }
+      print_model(m, in);
+    }
+
+    // keep the input that costs the most, then move one input
+    if (cycles >= best_cycles) {
+      best_cycles = cycles;
+      memcpy(best_in, in, sizeof(in));
+    } else {
+      memcpy(in, best_in, sizeof(in));
+    }
+    int i = rng.range(m.input_count);
+    in[i] = (rng.range(4) == 0) ? rng.uniform(-5, 105) : cand[i][rng.range(cand_count[i])];
+  }
+  st.models++;
+  free_engine(e);
+}
+
+static bool check_bound(uint64_t seed, uint64_t models, int steps) {
+  bound_stats_t st;
+  memset(&st, 0, sizeof(st));
+  for (uint64_t c = 0; c < models; c++) {
+    rng_t rng(seed ^ (c * 0x94D049BB133111EBULL));
+    model_spec_t m;
+    (c & 1) ? dense_model(rng, m) : random_model(rng, m);
+    check_bound_model(m, rng, steps, st);
+  }
+
+  printf("bound: %llu models, %llu evaluations, %llu over the bound\n",
+         (unsigned long long)st.models, (unsigned long long)st.evals,
+         (unsigned long long)st.violations);
+  printf("%-14s %12s %16s\n", "operation", "max counted", "max of bound");
+  for (int f = 0; f < OP_FIELD_COUNT; f++) {
+    printf("%-14s %12u %15.1f%%\n", op_fields[f].name, st.max_counted[f],
+           st.max_ratio[f] * 100);
+  }
+  printf("%-14s %12s %15.1f%%\n", "cycles", "", st.max_cycle_ratio * 100);
+  return st.violations == 0;
+}
+
+// ---------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+  uint64_t cases = 100000, seed = 1;
+  long single = -1;
+  int jobs = (int)std::thread::hardware_concurrency();
+  uint64_t bound_models = 2000;
+  bool verbose = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-n") && i + 1 < argc) cases = strtoull(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-j") && i + 1 < argc) jobs = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-s") && i + 1 < argc) seed = strtoull(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-u") && i + 1 < argc) max_ulp_allowed = strtoul(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-c") && i + 1 < argc) single = atol(argv[++i]);
+    else if (!strcmp(argv[i], "-b") && i + 1 < argc) bound_models = strtoull(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-v")) verbose = true;
+    else {
+      fprintf(stderr, "usage: %s [-n cases] [-j jobs] [-s seed] [-u max_ulp] [-c case] [-b models] [-v]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (jobs < 1) jobs = 1;
+
+  // a case is one model evaluated on INPUTS_PER_MODEL inputs, replayable
+  // from (seed, case)
+  uint64_t first = 0, last = (cases + INPUTS_PER_MODEL - 1) / INPUTS_PER_MODEL;
+  if (single >= 0) {
+    first = (uint64_t)single;
+    last = first + 1;
+    jobs = 1;
+  }
+
+  std::atomic<uint64_t> next(first);
+  std::atomic<uint64_t> failures(0);
+  std::mutex lock;
+  path_stats_t total[PATH_COUNT];
+  memset(total, 0, sizeof(total));
+
+  auto worker = [&]() {
+    path_stats_t st[PATH_COUNT];
+    memset(st, 0, sizeof(st));
+    for (uint64_t c; (c = next.fetch_add(1)) < last;) {
+      rng_t rng(seed ^ (c * 0xD1B54A32D192ED03ULL));
+      model_spec_t m;
+      random_model(rng, m);
+      float in[INPUTS_PER_MODEL][MAX_IO];
+      for (int k = 0; k < INPUTS_PER_MODEL; k++) {
+        random_inputs(rng, m, in[k]);
+      }
+      int k = 0;
+      if (run_case(m, in, INPUTS_PER_MODEL, st, &k) &&
+          failures.fetch_add(1) < 3) {
+        std::lock_guard<std::mutex> guard(lock);
+        report_failure(seed, c, m, in[k]);
+      }
+    }
+    std::lock_guard<std::mutex> guard(lock);
+    for (int p = 0; p < PATH_COUNT; p++) {
+      total[p].evals += st[p].evals;
+      total[p].outputs += st[p].outputs;
+      total[p].failures += st[p].failures;
+      total[p].fired_mismatch += st[p].fired_mismatch;
+      total[p].invalid += st[p].invalid;
+      total[p].sum_abs += st[p].sum_abs;
+      if (st[p].max_abs > total[p].max_abs) total[p].max_abs = st[p].max_abs;
+      if (st[p].max_ulp > total[p].max_ulp) total[p].max_ulp = st[p].max_ulp;
+    }
+  };
+
+  bool bound_ok = true;
+  if (single < 0 && bound_models > 0) {
+    bound_ok = check_bound(seed, bound_models, BOUND_STEPS);
+  }
+
+  auto t0 = std::chrono::steady_clock::now();
+  std::vector<std::thread> pool;
+  for (int j = 0; j < jobs; j++) pool.push_back(std::thread(worker));
+  for (size_t j = 0; j < pool.size(); j++) pool[j].join();
+  double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+  uint64_t evals = total[1].evals;
+  printf("%llu evaluations x %d paths, %d jobs, %.2f s, %.0f evaluations/s\n",
+         (unsigned long long)evals, PATH_COUNT, jobs, secs, evals / (secs > 0 ? secs : 1));
+  printf("%-10s %10s %12s %12s %9s %8s %8s\n", "path", "failures", "max abs", "mean abs",
+         "max ulp", "fired", "invalid");
+  for (int p = 1; p < PATH_COUNT; p++) {
+    const path_stats_t &st = total[p];
+    printf("%-10s %10llu %12.6g %12.6g %9u %8llu %8llu\n", diff_paths[p].name,
+           (unsigned long long)st.failures, st.max_abs,
+           st.outputs ? st.sum_abs / st.outputs : 0.0, st.max_ulp,
+           (unsigned long long)st.fired_mismatch, (unsigned long long)st.invalid);
+  }
+  if (verbose) {
+    printf("seed %llu, allowed ulp %u\n", (unsigned long long)seed, max_ulp_allowed);
+  }
+  return (failures.load() || !bound_ok) ? 1 : 0;
+}
@@ -0,0 +1,60 @@
+// Model description shared by fuzzy_diff and the frozen reference engine of
+// fuzzy_ref.cpp. Every evaluation path builds its own objects from it.
+
+#ifndef FUZZY_MODEL_H
+#define FUZZY_MODEL_H
+
+#define MAX_IO 3
+#define MAX_SETS 4
+#define MAX_RULES 10
+#define MAX_NODES 4
+#define MAX_CONSEQUENTS 2
+#define INPUTS_PER_MODEL 8
+
+struct set_spec_t {
+  float a, b, c, d;
+};
+
+struct io_spec_t {
+  int set_count;
+  set_spec_t sets[MAX_SETS];
+};
+
+// antecedent node, each operand is a set (input * MAX_SETS + set) or a node
+#define OP_SINGLE 0
+// OP_AND and OP_OR are the ones of FuzzyRuleAntecedent.h
+struct node_spec_t {
+  int op; // OP_SINGLE, OP_AND or OP_OR
+  int set[2];
+  int node[2]; // -1 when the operand is a set
+};
+
+struct rule_spec_t {
+  int node_count;
+  node_spec_t nodes[MAX_NODES]; // nodes[0] is the root
+  int out_count;
+  int out[MAX_CONSEQUENTS]; // output * MAX_SETS + set
+};
+
+struct model_spec_t {
+  int input_count, output_count, rule_count;
+  io_spec_t inputs[MAX_IO], outputs[MAX_IO];
+  rule_spec_t rules[MAX_RULES];
+};
+
+struct eval_result_t {
+  bool ok;
+  float out[MAX_IO];
+  int fired_count;
+  int fired[MAX_RULES];
+};
+
+// the frozen copy of the baseline engine in fuzzy_ref/, built in its own
+// namespace so that it links next to lib/Fuzzy
+struct ref_engine_t;
+ref_engine_t *ref_build(const model_spec_t &m);
+void ref_eval(ref_engine_t *e, const model_spec_t &m, const float *in,
+              eval_result_t &res);
+void ref_free(ref_engine_t *e);
+
+#endif
@@ -0,0 +1,151 @@
+// Reference path of fuzzy_diff: the Fuzzy engine as it was before the
+// arena, the antecedent rewrite and the deferred truncation, vendored in
+// fuzzy_ref/ from the baseline commit of lib/Fuzzy. It is compiled here
+// inside namespace fuzzy_ref, so the same class names link next to the
+// current lib/Fuzzy in one program. Do not update the copy when lib/Fuzzy
+// changes, a diff against it is what shows a change of behaviour.
+//
+// The only edits to the copy are the two memory fixes of
+// FuzzyComposition::build() and rebuild() (NULL dereference on an out of
+// order last point, points freed up to the wrong node). Without them the
+// baseline crashes on random models; neither changes an output.
+
+#include "fuzzy_model.h"
+
+// the system headers of the copy, outside the namespace
+#include <inttypes.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include <vector>
+
+namespace fuzzy_ref {
+#include "fuzzy_ref/Fuzzy.h"
+
+#include "fuzzy_ref/Fuzzy.cpp"
+#include "fuzzy_ref/FuzzyComposition.cpp"
+#include "fuzzy_ref/FuzzyIO.cpp"
+#include "fuzzy_ref/FuzzyInput.cpp"
+#include "fuzzy_ref/FuzzyOutput.cpp"
+#include "fuzzy_ref/FuzzyRule.cpp"
+#include "fuzzy_ref/FuzzyRuleAntecedent.cpp"
+#include "fuzzy_ref/FuzzyRuleConsequent.cpp"
+#include "fuzzy_ref/FuzzySet.cpp"
+}
+
+using namespace fuzzy_ref;
+
+struct ref_engine_t {
+  Fuzzy *fuzzy;
+  std::vector<FuzzySet *> sets;
+  std::vector<FuzzyInput *> inputs;
+  std::vector<FuzzyOutput *> outputs;
+  std::vector<FuzzyRule *> rules;
+  std::vector<FuzzyRuleAntecedent *> antecedents;
+  std::vector<FuzzyRuleConsequent *> consequents;
+};
+
+static FuzzyRuleAntecedent *build_node(ref_engine_t &e, const rule_spec_t &rule,
+                                       int n, FuzzySet **in_sets) {
+  const node_spec_t &node = rule.nodes[n];
+  FuzzyRuleAntecedent *ante = new FuzzyRuleAntecedent();
+  e.antecedents.push_back(ante);
+
+  FuzzySet *s0 = in_sets[node.set[0]], *s1 = in_sets[node.set[1]];
+  if (node.op == OP_SINGLE) {
+    ante->joinSingle(s0);
+    return ante;
+  }
+
+  FuzzyRuleAntecedent *a0 =
+      (node.node[0] >= 0) ? build_node(e, rule, node.node[0], in_sets) : NULL;
+  FuzzyRuleAntecedent *a1 =
+      (node.node[1] >= 0) ? build_node(e, rule, node.node[1], in_sets) : NULL;
+  bool is_and = (node.op == OP_AND);
+  if (a0 && a1) {
+    is_and ? ante->joinWithAND(a0, a1) : ante->joinWithOR(a0, a1);
+  } else if (a0) {
+    is_and ? ante->joinWithAND(a0, s1) : ante->joinWithOR(a0, s1);
+  } else if (a1) {
+    is_and ? ante->joinWithAND(s0, a1) : ante->joinWithOR(s0, a1);
+  } else {
+    is_and ? ante->joinWithAND(s0, s1) : ante->joinWithOR(s0, s1);
+  }
+  return ante;
+}
+
+ref_engine_t *ref_build(const model_spec_t &m) {
+  ref_engine_t *e = new ref_engine_t();
+  e->fuzzy = new Fuzzy();
+
+  FuzzySet *in_sets[MAX_IO * MAX_SETS], *out_sets[MAX_IO * MAX_SETS];
+  for (int i = 0; i < m.input_count; i++) {
+    FuzzyInput *input = new FuzzyInput(i);
+    e->inputs.push_back(input);
+    for (int j = 0; j < m.inputs[i].set_count; j++) {
+      const set_spec_t &s = m.inputs[i].sets[j];
+      FuzzySet *set = new FuzzySet(s.a, s.b, s.c, s.d);
+      e->sets.push_back(set);
+      in_sets[i * MAX_SETS + j] = set;
+      input->addFuzzySet(set);
+    }
+    e->fuzzy->addFuzzyInput(input);
+  }
+  for (int i = 0; i < m.output_count; i++) {
+    FuzzyOutput *output = new FuzzyOutput(i);
+    e->outputs.push_back(output);
+    for (int j = 0; j < m.outputs[i].set_count; j++) {
+      const set_spec_t &s = m.outputs[i].sets[j];
+      FuzzySet *set = new FuzzySet(s.a, s.b, s.c, s.d);
+      e->sets.push_back(set);
+      out_sets[i * MAX_SETS + j] = set;
+      output->addFuzzySet(set);
+    }
+    e->fuzzy->addFuzzyOutput(output);
+  }
+  for (int r = 0; r < m.rule_count; r++) {
+    const rule_spec_t &rule = m.rules[r];
+    FuzzyRuleConsequent *then = new FuzzyRuleConsequent();
+    e->consequents.push_back(then);
+    for (int k = 0; k < rule.out_count; k++) {
+      then->addOutput(out_sets[rule.out[k]]);
+    }
+    FuzzyRule *fr = new FuzzyRule(r, build_node(*e, rule, 0, in_sets), then);
+    e->rules.push_back(fr);
+    e->fuzzy->addFuzzyRule(fr);
+  }
+  return e;
+}
+
+// outputs read once in order, the fired rules in rule order as
+// Fuzzy::getFiredRules gives them
+void ref_eval(ref_engine_t *e, const model_spec_t &m, const float *in,
+              eval_result_t &res) {
+  for (int i = 0; i < m.input_count; i++) {
+    e->fuzzy->setInput(i, in[i]);
+  }
+  res.ok = e->fuzzy->fuzzify();
+  res.fired_count = 0;
+  for (int r = 0; r < m.rule_count; r++) {
+    if (e->fuzzy->isFiredRule(r)) {
+      res.fired[res.fired_count++] = r;
+    }
+  }
+  for (int o = 0; o < m.output_count; o++) {
+    res.out[o] = e->fuzzy->defuzzify(o);
+  }
+}
+
+void ref_free(ref_engine_t *e) {
+  if (e == NULL) {
+    return;
+  }
+  delete e->fuzzy;
+  for (size_t i = 0; i < e->rules.size(); i++) delete e->rules[i];
+  for (size_t i = 0; i < e->antecedents.size(); i++) delete e->antecedents[i];
+  for (size_t i = 0; i < e->consequents.size(); i++) delete e->consequents[i];
+  for (size_t i = 0; i < e->inputs.size(); i++) delete e->inputs[i];
+  for (size_t i = 0; i < e->outputs.size(); i++) delete e->outputs[i];
+  for (size_t i = 0; i < e->sets.size(); i++) delete e->sets[i];
+  delete e;
+}
@@ -0,0 +1,61 @@
+// Minimal stand-in for the Unity assertions used by the PlatformIO tests in
+// test/test_*, so test/host/Makefile can build them without PlatformIO.
+// Only what those tests use is here; "pio test -e native" uses real Unity.
+
+#ifndef UNITY_H
+#define UNITY_H
+
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+void setUp(void);
+void tearDown(void);
+
+static int unity_tests, unity_failures;
+static jmp_buf unity_abort;
+
+static inline void unity_fail(const char *file, int line, const char *msg,
+                              long long expected, long long actual) {
+  printf("%s:%d: FAIL: %s (expected %lld, was %lld)\n", file, line, msg,
+         expected, actual);
+  longjmp(unity_abort, 1);
+}
+
+static inline void unity_run(void (*test)(void), const char *name) {
+  unity_tests++;
+  if (setjmp(unity_abort) == 0) {
+    setUp();
+    test();
+    tearDown();
+    printf("%s: PASS\n", name);
+  } else {
+    unity_failures++;
+    tearDown();
+    printf("%s: FAIL\n", name);
+  }
+}
+
+#define UNITY_BEGIN() (unity_tests = unity_failures = 0)
+#define UNITY_END()                                                          \
+  (printf("%d tests, %d failures\n", unity_tests, unity_failures),          \
+   unity_failures)
+#define RUN_TEST(test) unity_run(test, #test)
+
+#define TEST_ASSERT_EQUAL_MESSAGE(expected, actual, msg)                     \
+  do {                                                                       \
+    long long e_ = (long long)(expected), a_ = (long long)(actual);          \
+    if (e_ != a_) unity_fail(__FILE__, __LINE__, msg, e_, a_);               \
+  } while (0)
+#define TEST_ASSERT_EQUAL(expected, actual)                                  \
+  TEST_ASSERT_EQUAL_MESSAGE(expected, actual, #actual)
+#define TEST_ASSERT_EQUAL_INT(expected, actual) TEST_ASSERT_EQUAL(expected, actual)
+#define TEST_ASSERT_EQUAL_UINT8(expected, actual) TEST_ASSERT_EQUAL(expected, actual)
+#define TEST_ASSERT_EQUAL_UINT32(expected, actual) TEST_ASSERT_EQUAL(expected, actual)
+#define TEST_ASSERT_TRUE(cond) TEST_ASSERT_EQUAL_MESSAGE(1, !!(cond), #cond)
+#define TEST_ASSERT_FALSE(cond) TEST_ASSERT_EQUAL_MESSAGE(0, !!(cond), #cond)
+#define TEST_ASSERT_EQUAL_STRING(expected, actual)                           \
+  TEST_ASSERT_EQUAL_MESSAGE(0, strcmp(expected, actual), #actual " == " #expected)
+
+#endif
@@ -279,9 +279,8 @@ void processLCDDisplayData() {
 void processDHTSensor() {
   if (t_now - t_last_dht_acquired >= 5000) {
     t_last_dht_acquired = t_now;
-    get_dht_data(&dht_sensor, &dht_sensor_output);
-
-    if (!dht_sensor_output.status_ok) {
+    if (wait_dht_data(&dht_sensor, &dht_sensor_output,
+                      DHT_DATA_WAIT_TIMEOUT) != DHT_DATA_OK) {
       APP_DEBUG_PRINT(F("DHT ERROR"));
     }
   }
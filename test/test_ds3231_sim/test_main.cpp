@@ -0,0 +1,179 @@
+// DS3231 alarm and calendar rollover tests on the simulated chip
+// (DS3231_SIM), run with "pio test -e native" or "make -C test/host check".
+
+#include <DS3231.h>
+#include <unity.h>
+
+DS3231 rtc(SDA, SCL);
+
+static uint32_t unix_of(uint16_t year, uint8_t mon, uint8_t date, uint8_t hour,
+                        uint8_t min, uint8_t sec) {
+  Time t;
+  t.year = year;
+  t.mon = mon;
+  t.date = date;
+  t.hour = hour;
+  t.min = min;
+  t.sec = sec;
+  return ds3231_unix_time(t);
+}
+
+static void assert_time(const Time &t, uint16_t year, uint8_t mon,
+                        uint8_t date, uint8_t hour, uint8_t min, uint8_t sec,
+                        uint8_t dow) {
+  TEST_ASSERT_EQUAL(year, t.year);
+  TEST_ASSERT_EQUAL(mon, t.mon);
+  TEST_ASSERT_EQUAL(date, t.date);
+  TEST_ASSERT_EQUAL(hour, t.hour);
+  TEST_ASSERT_EQUAL(min, t.min);
+  TEST_ASSERT_EQUAL(sec, t.sec);
+  TEST_ASSERT_EQUAL(dow, t.dow);
+}
+
+// advance the clock by steps of step_s seconds for total_s seconds, count
+// the alarm flags seen and clear them
+static uint16_t count_alarms(uint8_t alarm, uint32_t total_s, uint32_t step_s) {
+  uint16_t fired = 0;
+  for (uint32_t s = 0; s < total_s; s += step_s) {
+    ds3231_sim_advance(step_s * 1000);
+    if (rtc.checkAlarm(alarm)) {
+      TEST_ASSERT_TRUE(ds3231_sim_int());
+      rtc.clearAlarm(alarm);
+      TEST_ASSERT_FALSE(ds3231_sim_int());
+      fired++;
+    }
+  }
+  return fired;
+}
+
+void setUp(void) {
+  rtc.begin();
+  rtc.enableAlarm(ALARM_1, false);
+  rtc.enableAlarm(ALARM_2, false);
+  rtc.clearAlarm(ALARM_1);
+  rtc.clearAlarm(ALARM_2);
+}
+
+void tearDown(void) {}
+
+void test_year_rollover(void) {
+  // 2023-12-31 is a sunday
+  ds3231_sim_set_unix(unix_of(2023, 12, 31, 23, 59, 59));
+  ds3231_sim_advance(1000);
+  assert_time(rtc.getTime(), 2024, 1, 1, 0, 0, 0, MONDAY);
+}
+
+void test_leap_day_rollover(void) {
+  ds3231_sim_set_unix(unix_of(2024, 2, 28, 23, 59, 59));
+  ds3231_sim_advance(1000);
+  assert_time(rtc.getTime(), 2024, 2, 29, 0, 0, 0, THURSDAY);
+  ds3231_sim_advance(86400UL * 1000);
+  assert_time(rtc.getTime(), 2024, 3, 1, 0, 0, 0, FRIDAY);
+
+  ds3231_sim_set_unix(unix_of(2023, 2, 28, 23, 59, 59));
+  ds3231_sim_advance(1000);
+  assert_time(rtc.getTime(), 2023, 3, 1, 0, 0, 0, WEDNESDAY);
+}
+
+void test_millis_carry(void) {
+  // sub-second steps add up to whole seconds
+  ds3231_sim_set_unix(unix_of(2024, 6, 30, 23, 59, 58));
+  for (uint8_t i = 0; i < 8; i++) {
+    ds3231_sim_advance(250);
+  }
+  assert_time(rtc.getTime(), 2024, 7, 1, 0, 0, 0, MONDAY);
+}
+
+void test_alarm1_daily(void) {
+  ds3231_sim_set_unix(unix_of(2024, 1, 1, 0, 0, 0));
+  rtc.setAlarm1(ALARM1_MATCH_HOUR_MIN_SEC, 0, 7, 0, 0);
+  rtc.enableAlarm(ALARM_1, true);
+
+  uint16_t fired = 0;
+  for (uint16_t day = 0; day < 30; day++) {
+    uint16_t n = count_alarms(ALARM_1, 7UL * 3600, 60);
+    // the minute that ends at 07:00:00 carries the alarm
+    TEST_ASSERT_EQUAL(1, n);
+    Time t = rtc.getTime();
+    TEST_ASSERT_EQUAL(7, t.hour);
+    fired += n + count_alarms(ALARM_1, 17UL * 3600, 3600);
+  }
+  TEST_ASSERT_EQUAL(30, fired);
+}
+
+void test_alarm1_date_across_months(void) {
+  // the 29th exists in february 2024, march and april
+  ds3231_sim_set_unix(unix_of(2024, 2, 1, 0, 0, 0));
+  rtc.setAlarm1(ALARM1_MATCH_DATE, 29, 12, 0, 0);
+  rtc.enableAlarm(ALARM_1, true);
+  TEST_ASSERT_EQUAL(3, count_alarms(ALARM_1, 90UL * 86400, 3600));
+  assert_time(rtc.getTime(), 2024, 5, 1, 0, 0, 0, WEDNESDAY);
+
+  // and not in february 2023
+  ds3231_sim_set_unix(unix_of(2023, 2, 1, 0, 0, 0));
+  TEST_ASSERT_EQUAL(0, count_alarms(ALARM_1, 28UL * 86400, 3600));
+}
+
+void test_alarm2_every_minute(void) {
+  ds3231_sim_set_unix(unix_of(2024, 12, 31, 23, 0, 30));
+  rtc.setAlarm2(ALARM2_EVERY_MINUTE, 0, 0, 0);
+  rtc.enableAlarm(ALARM_2, true);
+  // two hours across the new year, one alarm per top of the minute
+  TEST_ASSERT_EQUAL(120, count_alarms(ALARM_2, 7200, 1));
+  assert_time(rtc.getTime(), 2025, 1, 1, 1, 0, 30, WEDNESDAY);
+}
+
+void test_alarm_not_routed(void) {
+  // the flag is set but INT stays high while the alarm is not enabled
+  ds3231_sim_set_unix(unix_of(2024, 1, 1, 6, 59, 59));
+  rtc.setAlarm1(ALARM1_MATCH_HOUR_MIN_SEC, 0, 7, 0, 0);
+  ds3231_sim_advance(1000);
+  TEST_ASSERT_TRUE(rtc.checkAlarm(ALARM_1));
+  TEST_ASSERT_FALSE(ds3231_sim_int());
+}
+
+void test_unix_time_after_2038(void) {
+  // past the signed 32-bit limit of 2038-01-19 03:14:07
+  uint32_t t = 0x80000000UL + 12345;
+  ds3231_sim_set_unix(t);
+  TEST_ASSERT_EQUAL_UINT32(t, rtc.getUnixTime(rtc.getTime()));
+  assert_time(rtc.getTimeFromUnix(t), 2038, 1, 19, 6, 39, 53, TUESDAY);
+  TEST_ASSERT_EQUAL_UINT32(unix_of(2099, 12, 31, 23, 59, 59),
+                           rtc.getUnixTime(rtc.getTimeFromUnix(4102444799UL)));
+}
+
+void test_unix_time_month_out_of_range(void) {
+  // a corrupt month register is clamped to 1..12, never read past the table
+  Time t = rtc.getTimeFromUnix(unix_of(2030, 6, 15, 12, 0, 0));
+  t.mon = 0;
+  TEST_ASSERT_EQUAL_UINT32(unix_of(2030, 1, 15, 12, 0, 0), ds3231_unix_time(t));
+  t.mon = 13;
+  TEST_ASSERT_EQUAL_UINT32(unix_of(2030, 12, 15, 12, 0, 0), ds3231_unix_time(t));
+  t.mon = 165;
+  TEST_ASSERT_EQUAL_UINT32(unix_of(2030, 12, 15, 12, 0, 0), ds3231_unix_time(t));
+}
+
+void test_format_out_of_range(void) {
+  // fields of 100 or more are printed modulo 100
+  Time t;
+  t.hour = 123;
+  t.min = 200;
+  t.sec = 255;
+  char buf[DS3231_TIME_STR_SIZE];
+  TEST_ASSERT_EQUAL_STRING("23:00:55", ds3231_format_time(t, buf));
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_year_rollover);
+  RUN_TEST(test_leap_day_rollover);
+  RUN_TEST(test_millis_carry);
+  RUN_TEST(test_alarm1_daily);
+  RUN_TEST(test_alarm1_date_across_months);
+  RUN_TEST(test_alarm2_every_minute);
+  RUN_TEST(test_alarm_not_routed);
+  RUN_TEST(test_unix_time_after_2038);
+  RUN_TEST(test_unix_time_month_out_of_range);
+  RUN_TEST(test_format_out_of_range);
+  return UNITY_END();
+}
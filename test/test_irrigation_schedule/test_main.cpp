@@ -0,0 +1,171 @@
+// IrrigationSchedule tests on the in-memory EEPROM of test/host/arduino,
+// run with "pio test -e native" or "make -C test/host check". The slot
+// search of nextAfter is checked against a minute by minute scan on random
+// schedules.
+
+#include <EEPROM.h>
+#include <IrrigationSchedule.h>
+#include <unity.h>
+
+#define MINUTE 60UL
+#define HOUR 3600UL
+#define DAY 86400UL
+
+// 2025-10-20 00:00, a monday
+#define MONDAY 1760918400UL
+
+// random schedules checked against the scan, slots walked per schedule
+#define BRUTE_CONFIGS 5000
+#define BRUTE_STEPS 4
+
+static uint32_t rng_state = 1;
+
+// xorshift32, the same sequence on every host
+static uint32_t rng(uint32_t n) {
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state % n;
+}
+
+// first slot strictly after a time, one minute at a time over 9 days
+static uint32_t scan_next(const irr_config_t &c, uint32_t after) {
+  for (uint32_t t = (after / MINUTE + 1) * MINUTE; t < after + 9 * DAY;
+       t += MINUTE) {
+    uint32_t day = t / DAY;
+    uint8_t dow_bit = 1 << ((day + 3) % 7);
+    uint16_t m = (t % DAY) / MINUTE;
+    for (uint8_t i = 0; i < c.window_count; i++) {
+      const irr_window_t &w = c.windows[i];
+      if (!(w.dow_mask & dow_bit)) {
+        continue;
+      }
+      if (w.every_min == 0) {
+        if (m == w.start_min) {
+          return t;
+        }
+      } else if ((m >= w.start_min) && (m <= w.end_min) &&
+                 ((m - w.start_min) % w.every_min == 0)) {
+        return t;
+      }
+    }
+  }
+  return IRR_NEVER;
+}
+
+void setUp(void) { arduino_eeprom_erase(); }
+
+void tearDown(void) {}
+
+void test_default_day(void) {
+  // the default schedule, 7 to 15 every 2 hours
+  IrrigationSchedule s;
+  s.begin(MONDAY + 6 * HOUR + 20 * MINUTE);
+  TEST_ASSERT_EQUAL(IRR_NO_WINDOW, s.catchup());
+  for (uint8_t h = 7; h <= 15; h += 2) {
+    TEST_ASSERT_EQUAL_UINT32(MONDAY + h * HOUR, s.next());
+    TEST_ASSERT_FALSE(s.due(s.next() - 1));
+    TEST_ASSERT_EQUAL(0, s.fire(s.next()));
+  }
+  TEST_ASSERT_EQUAL_UINT32(MONDAY + DAY + 7 * HOUR, s.next());
+  TEST_ASSERT_EQUAL(0, s.skipped());
+}
+
+void test_clock_forward(void) {
+  // set from 6:00 to 11:30, the 7:00 slot fires, 9:00 and 11:00 are skipped
+  IrrigationSchedule s;
+  s.begin(MONDAY + 6 * HOUR);
+  TEST_ASSERT_EQUAL(0, s.fire(MONDAY + 11 * HOUR + 30 * MINUTE));
+  TEST_ASSERT_EQUAL(2, s.skipped());
+  TEST_ASSERT_EQUAL_UINT32(MONDAY + 13 * HOUR, s.next());
+}
+
+void test_power_loss(void) {
+  IrrigationSchedule s;
+  s.begin(MONDAY + 6 * HOUR);
+  s.fire(MONDAY + 7 * HOUR);
+
+  // back three days later at 9:10, the 9:00 slot still runs, the 15 before
+  // it are dropped
+  IrrigationSchedule s2;
+  s2.begin(MONDAY + 3 * DAY + 9 * HOUR + 10 * MINUTE);
+  TEST_ASSERT_EQUAL(0, s2.catchup());
+  TEST_ASSERT_EQUAL(IRR_NO_WINDOW, s2.catchup());
+  TEST_ASSERT_EQUAL(15, s2.skipped());
+  TEST_ASSERT_EQUAL_UINT32(MONDAY + 3 * DAY + 11 * HOUR, s2.next());
+
+  // and again at 11:45, the 11:00 slot is too old to run
+  IrrigationSchedule s3;
+  s3.begin(MONDAY + 3 * DAY + 11 * HOUR + 45 * MINUTE);
+  TEST_ASSERT_EQUAL(IRR_NO_WINDOW, s3.catchup());
+  TEST_ASSERT_EQUAL(1, s3.skipped());
+}
+
+void test_every_min_range(void) {
+  IrrigationSchedule s;
+  irr_config_t c;
+  IrrigationSchedule::defaultConfig(&c);
+  s.begin(MONDAY);
+
+  // a day or more is rejected, the schedule is kept
+  c.windows[0].every_min = 1440;
+  TEST_ASSERT_FALSE(s.setConfig(&c, MONDAY));
+  c.windows[0].every_min = 0xFFFF;
+  TEST_ASSERT_FALSE(s.setConfig(&c, MONDAY));
+  TEST_ASSERT_EQUAL_UINT32(MONDAY + 7 * HOUR, s.next());
+
+  // just under a day is a single slot per day
+  c.windows[0].start_min = 0;
+  c.windows[0].end_min = 1439;
+  c.windows[0].every_min = 1439;
+  TEST_ASSERT_TRUE(s.setConfig(&c, MONDAY));
+  TEST_ASSERT_EQUAL_UINT32(MONDAY + 1439 * MINUTE, s.next());
+  s.fire(s.next());
+  TEST_ASSERT_EQUAL_UINT32(MONDAY + DAY, s.next());
+}
+
+void test_against_scan(void) {
+  IrrigationSchedule s;
+  s.begin(MONDAY);
+  uint16_t checked = 0;
+
+  for (uint16_t k = 0; k < BRUTE_CONFIGS; k++) {
+    irr_config_t c;
+    IrrigationSchedule::defaultConfig(&c);
+    c.window_count = 1 + rng(4);
+    for (uint8_t i = 0; i < c.window_count; i++) {
+      irr_window_t &w = c.windows[i];
+      w.start_min = rng(1440);
+      w.end_min = w.start_min + rng(1440 - w.start_min);
+      w.every_min = rng(3) ? 1 + rng(1439) : 0;
+      w.dow_mask = rng(128);
+      w.zone = 0;
+    }
+    // 2000-01-01 to 2099
+    uint32_t now = 946684800UL + rng(99UL * 365 * DAY);
+    TEST_ASSERT_TRUE(s.setConfig(&c, now));
+
+    // the first slots and the ones fire moves to
+    for (uint8_t n = 0; n < BRUTE_STEPS; n++) {
+      uint32_t expect = scan_next(c, now);
+      TEST_ASSERT_EQUAL_UINT32(expect, s.next());
+      checked++;
+      if (expect == IRR_NEVER) {
+        break;
+      }
+      now = expect + rng(2) * rng(DAY);
+      s.fire(now);
+    }
+  }
+  TEST_ASSERT_TRUE(checked >= BRUTE_CONFIGS);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_default_day);
+  RUN_TEST(test_clock_forward);
+  RUN_TEST(test_power_loss);
+  RUN_TEST(test_every_min_range);
+  RUN_TEST(test_against_scan);
+  return UNITY_END();
+}
@@ -0,0 +1,215 @@
+// CoopScheduler ordering and timing tests on the fake clock of
+// test/host/arduino, run with "pio test -e native" or
+// "make -C test/host check".
+
+#include <CoopScheduler.h>
+#include <unity.h>
+
+static CoopScheduler *sched;
+
+// ids of the tasks in the order they ran
+static int8_t order[32];
+static uint8_t order_len;
+
+static int8_t id_a, id_b, id_c;
+
+static void log_run(int8_t id) {
+  if (order_len < sizeof(order)) {
+    order[order_len++] = id;
+  }
+}
+
+static void task_a(void) { log_run(id_a); }
+static void task_b(void) { log_run(id_b); }
+static void task_c(void) { log_run(id_c); }
+
+// run every due task, returns how many ran
+static uint8_t run_due(void) {
+  uint8_t n = 0;
+  while (sched->run()) {
+    n++;
+  }
+  return n;
+}
+
+void setUp(void) {
+  arduino_set_millis(1000);
+  sched = new CoopScheduler();
+  order_len = 0;
+  id_a = id_b = id_c = SCHED_NO_TASK;
+}
+
+void tearDown(void) { delete sched; }
+
+void test_priority_order(void) {
+  id_a = sched->addTask(task_a, 100, 0);
+  id_b = sched->addTask(task_b, 100, 2);
+  id_c = sched->addTask(task_c, 100, 1);
+  TEST_ASSERT_EQUAL(3, run_due());
+  TEST_ASSERT_EQUAL(id_b, order[0]);
+  TEST_ASSERT_EQUAL(id_c, order[1]);
+  TEST_ASSERT_EQUAL(id_a, order[2]);
+}
+
+void test_earliest_deadline_first(void) {
+  // same priority, the deadline that passed first runs first
+  id_a = sched->addTask(task_a, 100, 1, 30);
+  id_b = sched->addTask(task_b, 100, 1, 10);
+  id_c = sched->addTask(task_c, 100, 1, 20);
+  arduino_advance_millis(50);
+  TEST_ASSERT_EQUAL(3, run_due());
+  TEST_ASSERT_EQUAL(id_b, order[0]);
+  TEST_ASSERT_EQUAL(id_c, order[1]);
+  TEST_ASSERT_EQUAL(id_a, order[2]);
+}
+
+void test_priority_over_deadline(void) {
+  // a higher priority task goes first even with a later deadline
+  id_a = sched->addTask(task_a, 100, 0, 0);
+  id_b = sched->addTask(task_b, 100, 1, 40);
+  arduino_advance_millis(50);
+  TEST_ASSERT_EQUAL(2, run_due());
+  TEST_ASSERT_EQUAL(id_b, order[0]);
+  TEST_ASSERT_EQUAL(id_a, order[1]);
+}
+
+void test_not_due(void) {
+  id_a = sched->addTask(task_a, 100, 0, 25);
+  TEST_ASSERT_FALSE(sched->run());
+  TEST_ASSERT_EQUAL_UINT32(25, sched->untilNext());
+  arduino_advance_millis(24);
+  TEST_ASSERT_FALSE(sched->run());
+  arduino_advance_millis(1);
+  TEST_ASSERT_EQUAL_UINT32(0, sched->untilNext());
+  TEST_ASSERT_TRUE(sched->run());
+}
+
+void test_period_without_drift(void) {
+  // a late start does not move the following deadlines
+  id_a = sched->addTask(task_a, 10);
+  for (uint8_t i = 0; i < 5; i++) {
+    arduino_advance_millis(3);
+    TEST_ASSERT_EQUAL(1, run_due());
+    TEST_ASSERT_EQUAL_UINT32(7, sched->untilNext());
+    arduino_advance_millis(7);
+  }
+  sched_stats_t stats;
+  TEST_ASSERT_TRUE(sched->getStats(id_a, &stats));
+  TEST_ASSERT_EQUAL_UINT32(5, stats.runs);
+  TEST_ASSERT_EQUAL(3, stats.late_max_ms);
+  TEST_ASSERT_EQUAL(0, stats.skipped);
+}
+
+void test_period_skipping(void) {
+  // 35 ms late on a 10 ms period: one run, three periods dropped
+  id_a = sched->addTask(task_a, 10);
+  arduino_advance_millis(35);
+  TEST_ASSERT_EQUAL(1, run_due());
+  TEST_ASSERT_EQUAL_UINT32(10, sched->untilNext());
+
+  sched_stats_t stats;
+  sched->getStats(id_a, &stats);
+  TEST_ASSERT_EQUAL(3, stats.skipped);
+  TEST_ASSERT_EQUAL(35, stats.late_max_ms);
+
+  // back on the new grid
+  arduino_advance_millis(10);
+  TEST_ASSERT_EQUAL(1, run_due());
+  sched->getStats(id_a, &stats);
+  TEST_ASSERT_EQUAL(3, stats.skipped);
+  TEST_ASSERT_EQUAL_UINT32(2, stats.runs);
+}
+
+static void task_reschedule(void) {
+  log_run(id_a);
+  sched->runIn(id_a, 7);
+}
+
+void test_run_in_from_task(void) {
+  // the task moves its own next run ahead of its period
+  id_a = sched->addTask(task_reschedule, 100);
+  TEST_ASSERT_EQUAL(1, run_due());
+  TEST_ASSERT_EQUAL_UINT32(7, sched->untilNext());
+  arduino_advance_millis(7);
+  TEST_ASSERT_EQUAL(1, run_due());
+  TEST_ASSERT_EQUAL(2, order_len);
+}
+
+static uint8_t rearm_left;
+
+static void task_rearm(void) {
+  log_run(id_b);
+  if (rearm_left) {
+    rearm_left--;
+    sched->runIn(id_b, 5);
+  }
+}
+
+void test_one_shot_rearm(void) {
+  // a one shot that calls runIn on itself runs again, then stops
+  rearm_left = 2;
+  id_b = sched->addOneShot(task_rearm, 5);
+  for (uint8_t i = 0; i < 5; i++) {
+    arduino_advance_millis(5);
+    run_due();
+  }
+  TEST_ASSERT_EQUAL(3, order_len);
+  TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFF, sched->untilNext());
+}
+
+static void task_start_other(void) {
+  log_run(id_a);
+  sched->runIn(id_c, 0);
+}
+
+void test_run_in_other_task(void) {
+  // a disabled task started by another one runs in the same pass
+  id_a = sched->addTask(task_start_other, 100, 1);
+  id_c = sched->addOneShot(task_c, 0);
+  sched->setActive(id_c, false);
+  TEST_ASSERT_EQUAL(2, run_due());
+  TEST_ASSERT_EQUAL(id_a, order[0]);
+  TEST_ASSERT_EQUAL(id_c, order[1]);
+}
+
+void test_millis_rollover(void) {
+  // deadlines on both sides of the 32-bit wrap keep their order
+  arduino_set_millis(0xFFFFFFFFUL - 15);
+  id_a = sched->addTask(task_a, 20, 0, 10);
+  id_b = sched->addTask(task_b, 20, 0, 20);
+  arduino_advance_millis(25);
+  TEST_ASSERT_TRUE(millis() < 100);
+  TEST_ASSERT_EQUAL(2, run_due());
+  TEST_ASSERT_EQUAL(id_a, order[0]);
+  TEST_ASSERT_EQUAL(id_b, order[1]);
+  TEST_ASSERT_EQUAL_UINT32(5, sched->untilNext());
+}
+
+static void task_slow(void) { arduino_advance_micros(300); }
+
+void test_run_time_stats(void) {
+  id_a = sched->addTask(task_slow, 10);
+  arduino_advance_millis(10);
+  run_due();
+  sched_stats_t stats;
+  sched->getStats(id_a, &stats);
+  TEST_ASSERT_EQUAL_UINT32(300, stats.run_max_us);
+  TEST_ASSERT_EQUAL_UINT32(300, stats.run_total_us);
+  TEST_ASSERT_EQUAL_UINT32(300, sched->busyTime());
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_priority_order);
+  RUN_TEST(test_earliest_deadline_first);
+  RUN_TEST(test_priority_over_deadline);
+  RUN_TEST(test_not_due);
+  RUN_TEST(test_period_without_drift);
+  RUN_TEST(test_period_skipping);
+  RUN_TEST(test_run_in_from_task);
+  RUN_TEST(test_one_shot_rearm);
+  RUN_TEST(test_run_in_other_task);
+  RUN_TEST(test_millis_rollover);
+  RUN_TEST(test_run_time_stats);
+  return UNITY_END();
+}